@@ -0,0 +1,351 @@
+// vose_bench.cpp
+// ============================================================
+// vose_core 性能ベンチマークスイート
+//
+// エンジン更新前後でこのスイートを実行し、ホットパスの回帰を
+// 出荷前に検出する。計測対象:
+//
+//   [micro] Harvest / Dio+StoneMask / CheapTrick / D4C（合成音声 1秒）
+//   [micro] apply_gender_shift / apply_tension_breath / apply_post_eq
+//   [cache] get_or_analyze のミス（フル解析）とヒット（LRU）
+//   [note ] synthesize_note_impl 短ノート(0.25s) / 長ノート(4s)
+//   [song ] execute_render 参考曲（60ノート ≒ 60秒)
+//            → 実時間係数 (RTF = 処理時間 / 曲長) とピークRSS
+//
+// 内部関数（synthesize_note_impl / get_or_analyze 等）を直接呼ぶため、
+// 共有ライブラリにリンクせずエンジンソースごと静的にビルドする
+// （CMakeLists.txt の VOSE_BUILD_BENCH を参照）。
+//
+// 音源は実行時に合成する（倍音列 + 微小ノイズ）。ノイズには起動毎の
+// 乱数シードを混ぜ、get_or_analyze のミス計測がディスクキャッシュに
+// 吸われないようにする。
+//
+// 使い方:
+//   cmake -S . -B build -DVOSE_BUILD_BENCH=ON
+//   cmake --build build -j && ./bin/vose_bench [出力WAVパス]
+// ============================================================
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "vose_core.h"
+#include "vose_core_internal.h"
+
+#include "world/harvest.h"
+#include "world/dio.h"
+#include "world/stonemask.h"
+#include "world/cheaptrick.h"
+#include "world/d4c.h"
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+
+constexpr int    kFs          = kFs_internal;
+constexpr double kFramePeriod = kFramePeriod_internal;
+
+// ------------------------------------------------------------
+// 計測ユーティリティ
+// ------------------------------------------------------------
+
+double now_ms() {
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ピークRSS [MB]。Linux の ru_maxrss は KB、macOS はバイト単位
+double peak_rss_mb() {
+#if defined(_WIN32) || defined(_WIN64)
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+        return 0.0;
+    return static_cast<double>(pmc.PeakWorkingSetSize) / (1024.0 * 1024.0);
+#else
+    struct rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) != 0) return 0.0;
+#if defined(__APPLE__)
+    return static_cast<double>(ru.ru_maxrss) / (1024.0 * 1024.0);
+#else
+    return static_cast<double>(ru.ru_maxrss) / 1024.0;
+#endif
+#endif
+}
+
+// fn を iters 回実行し「名前 / 反復数 / 合計 / 1回あたり」を出力する
+template <typename F>
+double bench(const char* name, int iters, F&& fn) {
+    const double t0 = now_ms();
+    for (int i = 0; i < iters; ++i) fn();
+    const double total = now_ms() - t0;
+    std::printf("  %-34s %4d 回  合計 %9.2f ms  1回 %9.3f ms\n",
+                name, iters, total, total / iters);
+    return total;
+}
+
+// ------------------------------------------------------------
+// 合成テスト音源
+//
+// 倍音列 (1/h ロールオフ) + 微小ノイズの擬似母音。ノイズに実行毎の
+// シードを混ぜ、内容・パスとも毎回ユニークにできるようにする。
+// ------------------------------------------------------------
+std::vector<int16_t> make_vowel(double seconds, double f0, uint32_t seed) {
+    const int n = static_cast<int>(seconds * kFs);
+    std::vector<int16_t> wav(n);
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> noise(-1.0, 1.0);
+    for (int i = 0; i < n; ++i) {
+        const double t = static_cast<double>(i) / kFs;
+        double v = 0.0;
+        for (int h = 1; h <= 8; ++h)
+            v += std::sin(2.0 * M_PI * f0 * h * t) / h;
+        v = v * 0.25 + noise(rng) * 0.002;
+        // 頭とお尻に 10ms のフェードを入れてクリックを避ける
+        const int fade = kFs / 100;
+        if (i < fade)          v *= static_cast<double>(i) / fade;
+        else if (i >= n - fade) v *= static_cast<double>(n - 1 - i) / fade;
+        wav[i] = static_cast<int16_t>(v * 32767.0);
+    }
+    return wav;
+}
+
+// pitch_length 指定でフラットピッチの NoteEvent を組み立てる
+struct BenchNote {
+    std::vector<double> pitch;
+    NoteEvent           ev{};
+
+    BenchNote(const char* phoneme, int pitch_length, double hz)
+        : pitch(pitch_length, hz)
+    {
+        ev.wav_path     = phoneme;
+        ev.pitch_curve  = pitch.data();
+        ev.pitch_length = pitch_length;
+    }
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const char* out_path = (argc > 1) ? argv[1] : "vose_bench_out.wav";
+
+    const uint32_t seed = static_cast<uint32_t>(
+        std::chrono::steady_clock::now().time_since_epoch().count());
+
+    std::printf("vose_bench (fs=%d, frame=%.1fms, workers=%d)\n",
+                kFs, kFramePeriod, vose_worker_pool().worker_count());
+
+    // --------------------------------------------------------
+    // 音源登録（内容は起動毎にユニーク）
+    // --------------------------------------------------------
+    const auto wav_a = make_vowel(1.0, 220.0, seed + 1);
+    const auto wav_i = make_vowel(1.0, 260.0, seed + 2);
+    const auto wav_u = make_vowel(1.0, 196.0, seed + 3);
+    load_embedded_resource("bench_a", wav_a.data(),
+                           static_cast<int>(wav_a.size()));
+    load_embedded_resource("bench_i", wav_i.data(),
+                           static_cast<int>(wav_i.size()));
+    load_embedded_resource("bench_u", wav_u.data(),
+                           static_cast<int>(wav_u.size()));
+
+    CheapTrickOption ct_probe;
+    InitializeCheapTrickOption(kFs, &ct_probe);
+    const int fft_size  = ct_probe.fft_size;
+    const int spec_bins = fft_size / 2 + 1;
+
+    // --------------------------------------------------------
+    // [micro] WORLD 解析（本番と同じオプション設定）
+    // --------------------------------------------------------
+    std::printf("\n[micro] WORLD 解析 (1.0s 音声)\n");
+    {
+        std::vector<double> x(wav_a.size());
+        for (size_t i = 0; i < wav_a.size(); ++i)
+            x[i] = static_cast<double>(wav_a[i]) / 32768.0;
+        const int x_len  = static_cast<int>(x.size());
+        const int f0_len = GetSamplesForHarvest(kFs, x_len, kFramePeriod);
+
+        std::vector<double> time_axis(f0_len), f0(f0_len), refined(f0_len);
+
+        HarvestOption hv;
+        InitializeHarvestOption(&hv);
+        hv.frame_period = kFramePeriod;
+        hv.f0_floor     = 50.0;
+        hv.f0_ceil      = 800.0;
+        hv.n_threads    = vose_worker_pool().worker_count();
+        bench("Harvest", 3, [&] {
+            Harvest(x.data(), x_len, kFs, &hv, time_axis.data(), f0.data());
+        });
+
+        DioOption dio;
+        InitializeDioOption(&dio);
+        dio.frame_period = kFramePeriod;
+        dio.f0_floor     = 50.0;
+        dio.f0_ceil      = 800.0;
+        bench("Dio + StoneMask", 3, [&] {
+            Dio(x.data(), x_len, kFs, &dio, time_axis.data(), f0.data());
+            StoneMask(x.data(), x_len, kFs, time_axis.data(), f0.data(),
+                      f0_len, refined.data());
+        });
+
+        const size_t sc = static_cast<size_t>(f0_len) * spec_bins;
+        std::vector<double>  spec_work(sc), ap_work(sc);
+        std::vector<double*> sp(f0_len), ap(f0_len);
+        for (int i = 0; i < f0_len; ++i) {
+            sp[i] = &spec_work[static_cast<size_t>(i) * spec_bins];
+            ap[i] = &ap_work  [static_cast<size_t>(i) * spec_bins];
+        }
+
+        CheapTrickOption ct;
+        InitializeCheapTrickOption(kFs, &ct);
+        ct.fft_size  = fft_size;
+        ct.n_threads = vose_worker_pool().worker_count();
+        bench("CheapTrick", 5, [&] {
+            CheapTrick(x.data(), x_len, kFs, time_axis.data(), f0.data(),
+                       f0_len, &ct, sp.data());
+        });
+
+        D4COption d4c;
+        InitializeD4COption(&d4c);
+        d4c.n_threads = vose_worker_pool().worker_count();
+        bench("D4C", 5, [&] {
+            D4C(x.data(), x_len, kFs, time_axis.data(), f0.data(),
+                f0_len, fft_size, &d4c, ap.data());
+        });
+    }
+
+    // --------------------------------------------------------
+    // [micro] スペクトル / 波形 DSP カーネル
+    // --------------------------------------------------------
+    std::printf("\n[micro] DSP カーネル (spec_bins=%d)\n", spec_bins);
+    {
+        // 減衰包絡の擬似スペクトル。カーネルは in-place 変形なので
+        // 反復毎に原本から複製する（複製コストは exp/log に比べ微小）
+        std::vector<double> sr0(spec_bins), ar0(spec_bins);
+        for (int k = 0; k < spec_bins; ++k) {
+            sr0[k] = 1e-4 + std::exp(-static_cast<double>(k) / 200.0);
+            ar0[k] = 0.1 + 0.8 * k / spec_bins;
+        }
+        std::vector<double> sr(spec_bins), ar(spec_bins), tmp(spec_bins);
+
+        bench("apply_gender_shift", 2000, [&] {
+            sr = sr0;
+            apply_gender_shift(sr.data(), spec_bins, 0.3, tmp.data(), 1.2);
+        });
+        bench("apply_tension_breath", 2000, [&] {
+            sr = sr0; ar = ar0;
+            apply_tension_breath(sr.data(), ar.data(), spec_bins, 0.7, 0.65);
+        });
+
+        std::vector<double> y0(kFs), y(kFs);   // 1秒ぶんの波形
+        for (int i = 0; i < kFs; ++i)
+            y0[i] = 0.3 * std::sin(2.0 * M_PI * 220.0 * i / kFs);
+        bench("apply_post_eq (1.0s)", 50, [&] {
+            y = y0;
+            apply_post_eq(y.data(), kFs);
+        });
+    }
+
+    // --------------------------------------------------------
+    // [cache] get_or_analyze ミス / ヒット
+    //
+    // ミス計測は起動毎にユニークなキーを使い、ディスクキャッシュ
+    // (cache/) に残った過去の結果に吸われないようにする
+    // --------------------------------------------------------
+    std::printf("\n[cache] get_or_analyze\n");
+    {
+        char miss_key[64];
+        std::snprintf(miss_key, sizeof(miss_key), "bench_miss_%u", seed);
+        const auto wav_m = make_vowel(1.0, 233.0, seed + 4);
+        load_embedded_resource(miss_key, wav_m.data(),
+                               static_cast<int>(wav_m.size()));
+        auto ev = find_voice_ref(miss_key);
+
+        bench("ミス (Harvest+CheapTrick+D4C)", 1, [&] {
+            get_or_analyze(ev, fft_size, spec_bins);
+        });
+        bench("ヒット (メモリLRU)", 10000, [&] {
+            get_or_analyze(ev, fft_size, spec_bins);
+        });
+    }
+
+    // --------------------------------------------------------
+    // [note] synthesize_note_impl（解析はウォーム済み）
+    // --------------------------------------------------------
+    std::printf("\n[note] synthesize_note_impl\n");
+    {
+        auto ev = find_voice_ref("bench_a");
+        get_or_analyze(ev, fft_size, spec_bins);   // ウォームアップ
+
+        // pitch_length → サンプル数は (len-1) * frame_period 換算
+        BenchNote short_note("bench_a",  51, 220.0);   // 0.25s
+        BenchNote long_note ("bench_a", 801, 220.0);   // 4.0s
+
+        const int64_t ns_short =
+            static_cast<int64_t>((51  - 1) * kFramePeriod / 1000.0 * kFs) + 1;
+        const int64_t ns_long  =
+            static_cast<int64_t>((801 - 1) * kFramePeriod / 1000.0 * kFs) + 1;
+
+        NotePrepass pp_short(NoteState::RENDERABLE, ns_short, ev);
+        NotePrepass pp_long (NoteState::RENDERABLE, ns_long,  ev);
+
+        std::vector<double> buf;
+        bench("短ノート (0.25s)", 50, [&] {
+            SynthNoteParams p{ pp_short, short_note.ev, fft_size, spec_bins };
+            synthesize_note_impl(p, buf);
+        });
+        bench("長ノート (4.0s)", 10, [&] {
+            SynthNoteParams p{ pp_long, long_note.ev, fft_size, spec_bins };
+            synthesize_note_impl(p, buf);
+        });
+    }
+
+    // --------------------------------------------------------
+    // [song] execute_render 参考曲（60ノート × 1s、3音素ローテーション）
+    // --------------------------------------------------------
+    std::printf("\n[song] execute_render (60ノート)\n");
+    {
+        const char* phonemes[3] = { "bench_a", "bench_i", "bench_u" };
+        std::vector<BenchNote> song;
+        song.reserve(60);
+        for (int i = 0; i < 60; ++i)
+            song.emplace_back(phonemes[i % 3], 201,
+                              220.0 * std::pow(2.0, (i % 12) / 12.0));
+        std::vector<NoteEvent> events;
+        events.reserve(song.size());
+        for (auto& n : song) events.push_back(n.ev);
+
+        const double song_sec =
+            song.size() * (201 - 1) * kFramePeriod / 1000.0;
+
+        // 1回目はコールド（全音素の解析込み）、2回目はウォーム
+        const double cold = bench("フルレンダ (コールド)", 1, [&] {
+            execute_render(events.data(), static_cast<int>(events.size()),
+                           out_path, /*mode_flag=*/0);
+        });
+        const double warm = bench("フルレンダ (ウォーム)", 1, [&] {
+            execute_render(events.data(), static_cast<int>(events.size()),
+                           out_path, /*mode_flag=*/0);
+        });
+
+        std::printf("\n  曲長 %.1f s / RTF コールド %.4f / ウォーム %.4f\n",
+                    song_sec, cold / 1000.0 / song_sec,
+                    warm / 1000.0 / song_sec);
+    }
+
+    std::printf("\nピークRSS: %.1f MB\n", peak_rss_mb());
+    std::printf("出力: %s\n", out_path);
+    return 0;
+}
@@ -11,13 +11,44 @@
 
 #include <cstdint> 
 
-// ディスクキャッシュの先頭に書き込むヘッダ情報
+// ディスクキャッシュ（スペクトル層 .vsc）の先頭に書き込むヘッダ情報
+// version 2: flat_spec は log振幅の float32、flat_ap は float32。
+//   double 格納の v1 に比べてメモリ・ディスクとも半減し、
+//   同じ 1GB 予算で LRU が2倍のエントリを保持できる。
 struct VoseCacheHeader {
     uint32_t magic;     // 'VOSE' (0x45534F56) かどうかを確認するマジックナンバー
+    uint32_t version;   // フォーマット版数 (現行 = 2)
     int length;         // フレーム数
     int spec_bins;      // 周波数ビン数
 };
 
+// F0層 (.vsf) のヘッダ情報。fft_size に依存しないため、
+// CheapTrick/D4C の設定が変わっても Harvest の結果を再利用できる
+struct VoseF0CacheHeader {
+    uint32_t magic;     // 'VOSF' (0x46534F56)
+    int length;         // フレーム数
+};
+
+// パック音源バンク (.vpk) のファイル形式:
+//   VoseBankHeader + VoseBankEntry[entry_count] + 連結 int16 PCM
+// modules/tools/pack_all_voices.py --vpk が生成し、
+// load_voicebank_pack が mmap で読み込む。両構造体とも
+// 4バイト境界でパディングなし（サイズ 16 / 80 バイト固定）。
+struct VoseBankHeader {
+    uint32_t magic;        // 'VOSB' (0x42534F56)
+    uint32_t version;      // フォーマット版数 (現行 = 1)
+    uint32_t entry_count;  // インデックスのエントリ数
+    uint32_t reserved;     // 0
+};
+
+struct VoseBankEntry {
+    char     alias[64];      // 登録名 (UTF-8, NUL 終端)
+    uint32_t sample_offset;  // PCM 先頭からのオフセット [サンプル]
+    uint32_t sample_count;   // サンプル数
+    uint32_t fs;             // サンプリングレート [Hz]
+    uint32_t reserved;       // 0
+};
+
 // --- GUI（Python）とやり取りするための構造体 ---
 // 64bit/32bit環境でサイズが変わらないよう、アライメントを厳密に制御します
 
@@ -55,18 +86,101 @@ struct NoteEvent {
 
 struct OtoEntry; // 前方宣言
 
+// エンジン統計スナップショット (get_engine_stats)
+// カウンタはエンジン起動（または reset_engine_stats）からの累積値。
+// 計測は relaxed atomic の加算のみなので本番でも常時有効にできる。
+struct VoseEngineStats {
+    // 解析キャッシュ (メモリLRU)
+    uint64_t cache_hits;         // get_or_analyze の初回ルックアップ成功数
+    uint64_t cache_misses;       // 同・失敗数（ディスク読込か再解析へ）
+    uint64_t cache_evictions;    // LRU から追い出されたエントリ数
+    uint64_t cache_entries;      // 現在の保持エントリ数
+
+    // ディスクキャッシュ I/O（読み書きした実データ量と所要時間）
+    uint64_t disk_load_bytes;
+    uint64_t disk_load_ns;
+    uint64_t disk_save_bytes;
+    uint64_t disk_save_ns;
+
+    // ノート合成のステージ別累積時間
+    uint64_t synth_notes;        // 合成したノート数
+    uint64_t synth_spectral_ns;  // スペクトル展開 + DSP + トランジション
+    uint64_t synth_f0_ns;        // F0 平滑化 + ビブラート
+    uint64_t synth_world_ns;     // VOSE_Synthesis (WORLD)
+    uint64_t synth_posteq_ns;    // ポストEQ
+
+    // ストリーミング
+    uint64_t stream_underruns;   // pull が要求サンプル数を満たせなかった回数
+};
+
 
 extern "C" {
     // 1. 音源をメモリにパッキングする（内蔵音源化の必須関数）
     DLLEXPORT void load_embedded_resource(const char* phoneme, const int16_t* raw_data, int sample_count);
 
+    // 1b. パック音源バンク (.vpk) を mmap で一括登録する
+    // 波形はコピーされず int16 ビューのまま保持され、double への
+    // 変換は解析の初回タッチまで遅延される。起動はインデックス走査
+    // のみで、未使用音素は常駐メモリをほぼ消費しない。
+    // 戻り値: 登録した音素数（0 = ファイル不正/オープン失敗）
+    DLLEXPORT int load_voicebank_pack(const char* path);
+
     // 2. レンダリング実行関数
+    // mode_flag はビットフラグ:
+    //   bit0 (1) = Pro (Studio Master)
+    //   bit1 (2) = セグメントレンダリング: 曲全体のバッファを確保せず
+    //              数秒の窓単位で合成→WAV追記→解放する。ピークメモリが
+    //              曲長に依存しなくなる（長尺曲・省メモリ機向け）。
+    //              このモードはインクリメンタル再レンダリング用の
+    //              セッションを残さず、BigVGAN も通らない（WORLD出力を
+    //              直接書く。フラッシュ境界でメルの STFT コンテキストと
+    //              ボコーダ出力の重畳が途切れるため）。BigVGAN 品質が
+    //              必要な場合は bit1 を立てずにレンダリングすること。
     DLLEXPORT void execute_render(NoteEvent* notes, int note_count, const char* output_path, int mode_flag);
 
+    // 2b. インクリメンタル再レンダリング
+    // 直前の execute_render の結果（曲バッファ・ノートバッファ）を再利用し、
+    // [changed_from_idx, changed_to_idx] のノートとそのクロスフェード隣接
+    // ノートだけを合成し直す。セッションが再利用できない場合は自動的に
+    // フルレンダリングへフォールバックする。
+    DLLEXPORT void execute_render_incremental(NoteEvent* notes, int note_count,
+                                              int changed_from_idx, int changed_to_idx,
+                                              const char* output_path, int mode_flag);
+
     
     // 3. エンジン管理
     DLLEXPORT float get_engine_version(void);
     DLLEXPORT void clear_engine_cache(void);
+
+    // 3b. エンジン統計
+    // out に現在の累積カウンタを書き込む（スナップショット取得中も
+    // 計測は止まらない。フィールド間の完全な一貫性は保証しない）。
+    DLLEXPORT void get_engine_stats(VoseEngineStats* out);
+    DLLEXPORT void reset_engine_stats(void);
+
+    // 4. 解析キャッシュのプリウォーム
+    // 指定した音素の解析（Harvest + CheapTrick + D4C）をワーカープールで
+    // バックグラウンド実行する。呼び出しは即座に戻る。
+    // init_official_engine は登録済み全音素を自動でプリウォームするため、
+    // 通常はこのAPIを明示的に呼ぶ必要はない（バンク差し替え時用）。
+    DLLEXPORT void prewarm_analysis_cache(const char** phonemes, int count);
+
+    // 4b. ウォームキャッシュ プリロード（clear_engine_cache の逆向き）
+    // save_engine_session: 現在メモリLRUに載っているキャッシュキーを
+    //   cache/session.manifest へ書き出す（エディタ終了時に呼ぶ）。
+    // preload_engine_cache: 指定キー（phonemes=NULL ならマニフェストの
+    //   キー）をディスクキャッシュ (.vsf/.vsc) からワーカープールで
+    //   並列読み込みし、LRU を再充填してから返る。解析は走らない
+    //   （層が無いキーはスキップ）。戻り値 = 常駐済みにした件数。
+    DLLEXPORT void save_engine_session(void);
+    DLLEXPORT int  preload_engine_cache(const char** phonemes, int count);
+
+    // 5. 解析品質ティア
+    // 0 = プレビュー（Dio + StoneMask による高速F0推定。スクラブ中の
+    //     ストリーミング再生向け）、1 = 最終（Harvest。デフォルト）。
+    // プレビューと最終は別キャッシュエントリなので、品質を戻しても
+    // 再解析は1回きりで済む。
+    DLLEXPORT void set_analysis_quality(int quality);
 }
 
 #endif // VOSE_CORE_H
@@ -13,21 +13,42 @@
 // 前方宣言 / 構造体
 // ============================================================
 
+struct MmapFile;  // vose_core.cpp 内部定義（ディスクキャッシュの mmap と共用）
+
+// 波形は int16 のまま保持し、double への変換は解析の初回タッチまで
+// 遅延する。ソースは「所有ベクタ (load_embedded_resource)」または
+// 「.vpk の mmap ビュー (load_voicebank_pack)」のどちらか。
 struct EmbeddedVoice {
-    std::string         path;
-    std::vector<double> waveform;
-    int                 fs;
-};
+    std::string path;
+    int         fs = 44100;
+
+    std::vector<int16_t>      raw_store;            // 所有コピー
+    const int16_t*            raw_view   = nullptr; // mmap ビュー
+    int                       raw_length = 0;
+    std::shared_ptr<MmapFile> raw_map;              // ビューの寿命保持
+
+    int            length()   const { return raw_length; }
+    const int16_t* raw_data() const {
+        return raw_view ? raw_view : raw_store.data();
+    }
 
-struct AnalysisCache {
-    std::vector<double> f0;
-    std::vector<double> time;
-    int                 length    = 0;
-    std::vector<double> flat_spec;
-    std::vector<double> flat_ap;
-    int                 spec_bins = 0;
+    // int16 → double デコード。Harvest/CheapTrick/D4C の入力にだけ
+    // 必要なので呼び出し側のローカルに持たせ、解析後に解放する。
+    std::vector<double> decode_waveform() const {
+        std::vector<double> w(raw_length);
+        const int16_t* src = raw_data();
+        for (int i = 0; i < raw_length; ++i)
+            w[i] = static_cast<double>(src[i]) * (1.0 / 32768.0);
+        return w;
+    }
 };
 
+// 解析キャッシュ本体は vose_core.cpp 内部定義（mmap ビュー層を含む）。
+// 他の翻訳単位は shared_ptr<const AnalysisCache> を受け渡すだけで
+// メンバには触れないため、ここでは不完全型のままにしておく
+// （完全定義を複製すると vose_core.cpp 側と黙って食い違う）。
+struct AnalysisCache;
+
 enum class NoteState : uint8_t { INVALID, NO_VOICE, RENDERABLE };
 
 struct NotePrepass {
@@ -47,24 +68,12 @@ struct NotePrepass {
     { if (o) { oto = *o; has_oto = true; } }
 };
 
-struct SynthesisScratchPad {
-    std::vector<double>  flat_spec, flat_ap, spec_tmp;
-    std::vector<double*> spec_ptrs, ap_ptrs;
-    std::vector<double>  f0, time_axis;
-
-    std::vector<double>  flat_spec_prev, flat_ap_prev;
-    std::vector<double*> spec_ptrs_prev, ap_ptrs_prev;
-    std::vector<double>  f0_prev, time_axis_prev;
-
-    std::vector<double>  flat_mod_ap;
-    std::vector<double*> mod_ap_ptrs;
-
-    int reserved_f0 = 0, reserved_bins = 0;
-
-    void ensure_spec(int f0_length, int spec_bins);
-    void ensure_f0(int n);
-    void ensure_f0_prev(int n);
-};
+// 合成スクラッチパッド本体は vose_core.cpp 内部定義。
+// 各ワーカーの thread_local インスタンス（tl_scratch）には
+// synthesize_note_impl 経由でしか触れないため、AnalysisCache と
+// 同じく不完全型のままにしておく（完全定義を複製すると
+// vose_core.cpp 側と黙って食い違う）。
+struct SynthesisScratchPad;
 
 struct SynthNoteParams {
     const NotePrepass& pp;
@@ -72,15 +81,134 @@ struct SynthNoteParams {
     int                fft_size;
     int                spec_bins;
     double             global_time_sec = 0.0;
+
+    // 品質ティア (ストリーミングのガバナーが設定。レンダリングは常に 0):
+    //   0 = フル品質
+    //   1 = ポストEQ省略
+    //   2 = + 帯気変調省略（D4C の ap をそのまま使用）
+    //   3 = + Dio 解析ティアへフォールバック
+    int                quality_tier = 0;
 };
 
+// ============================================================
+// 永続ワーカープール (vose_thread_pool.h)
+// ============================================================
+#include "vose_thread_pool.h"
+
 // ============================================================
 // oto.ini DB への参照
 // ============================================================
-#include <map>
 #include <mutex>
-extern std::map<std::string, OtoEntry> g_oto_db;
-extern std::mutex                      g_oto_db_mutex;
+
+// FNV-1a ハッシュ（vose_core.cpp の static 定義と同一値を返すこと）
+inline uint64_t vose_fnv1a_hash(const char* str) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (; *str; ++str) {
+        hash ^= static_cast<uint64_t>(*str);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// RCU 風スナップショット辞書（vose_core.cpp と手動同期）。
+// 読み手は oto_snapshot() で不変スナップショットを1回取得し、
+// 以降ロックなしで find する。2冪サイズ + 線形探索のフラット配列で、
+// 文字列比較はハッシュ一致時の最終確認1回のみ。
+template <typename Value>
+struct FlatSnapshotMap {
+    struct Slot {
+        uint64_t    hash = 0;
+        bool        used = false;
+        std::string key;
+        Value       value{};
+    };
+    std::vector<Slot> slots;
+    size_t            count = 0;
+
+    FlatSnapshotMap() : slots(16) {}
+
+    const Value* find(const char* key) const {
+        if (!key) return nullptr;
+        const uint64_t h    = vose_fnv1a_hash(key);
+        const size_t   mask = slots.size() - 1;
+        for (size_t i = h & mask; slots[i].used; i = (i + 1) & mask)
+            if (slots[i].hash == h && slots[i].key == key)
+                return &slots[i].value;
+        return nullptr;
+    }
+
+    template <typename F>
+    void for_each(F&& f) const {
+        for (const Slot& s : slots)
+            if (s.used) f(s.key, s.value);
+    }
+
+    // 書き手専用。公開（atomic_store）前の構築中にのみ呼ぶこと
+    void insert(const std::string& key, Value value) {
+        if ((count + 1) * 4 >= slots.size() * 3) rehash(slots.size() * 2);
+        insert_slot(vose_fnv1a_hash(key.c_str()), key, std::move(value));
+    }
+
+private:
+    void insert_slot(uint64_t h, const std::string& key, Value value) {
+        const size_t mask = slots.size() - 1;
+        size_t i = h & mask;
+        while (slots[i].used) {
+            if (slots[i].hash == h && slots[i].key == key) {
+                slots[i].value = std::move(value);
+                return;
+            }
+            i = (i + 1) & mask;
+        }
+        slots[i].hash  = h;
+        slots[i].used  = true;
+        slots[i].key   = key;
+        slots[i].value = std::move(value);
+        ++count;
+    }
+
+    void rehash(size_t new_size) {
+        std::vector<Slot> old = std::move(slots);
+        slots.assign(new_size, Slot());
+        count = 0;
+        for (Slot& s : old)
+            if (s.used) insert_slot(s.hash, s.key, std::move(s.value));
+    }
+};
+
+using OtoMap   = FlatSnapshotMap<OtoEntry>;
+using VoiceMap = FlatSnapshotMap<std::shared_ptr<const EmbeddedVoice>>;
+
+// 現行スナップショットの取得（ロックなし読み取りの入口）
+std::shared_ptr<const OtoMap>   oto_snapshot();
+std::shared_ptr<const VoiceMap> voice_snapshot();
+
+// ============================================================
+// エンジン統計カウンタ（vose_core.cpp と手動同期）
+//
+// get_engine_stats が公開するカウンタの実体。ホットパスからは
+// fetch_add(relaxed) のみで触れるため本番でも常時有効にできる。
+// 実体は vose_core.cpp の g_engine_stats。
+// ============================================================
+#include <atomic>
+
+struct VoseStatsCounters {
+    std::atomic<uint64_t> cache_hits{0};
+    std::atomic<uint64_t> cache_misses{0};
+    std::atomic<uint64_t> cache_evictions{0};
+    std::atomic<uint64_t> disk_load_bytes{0};
+    std::atomic<uint64_t> disk_load_ns{0};
+    std::atomic<uint64_t> disk_save_bytes{0};
+    std::atomic<uint64_t> disk_save_ns{0};
+    std::atomic<uint64_t> synth_notes{0};
+    std::atomic<uint64_t> synth_spectral_ns{0};
+    std::atomic<uint64_t> synth_f0_ns{0};
+    std::atomic<uint64_t> synth_world_ns{0};
+    std::atomic<uint64_t> synth_posteq_ns{0};
+    std::atomic<uint64_t> stream_underruns{0};
+};
+
+extern VoseStatsCounters g_engine_stats;
 
 // ============================================================
 // スレッドローカルスクラッチパッド (各スレッドで独立)
@@ -95,8 +223,11 @@ extern thread_local SynthesisScratchPad tl_scratch;
 std::shared_ptr<const EmbeddedVoice> find_voice_ref(const char* key);
 
 // 解析キャッシュ (メモリ + ディスク 2段キャッシュ)
+// quality_override: -1 = グローバル設定 (set_analysis_quality) に従う、
+//                    0 = Dio プレビュー強制、1 = Harvest 最終品質強制
 std::shared_ptr<const AnalysisCache>
-get_or_analyze(std::shared_ptr<const EmbeddedVoice> ev_sp, int fft_size, int spec_bins);
+get_or_analyze(std::shared_ptr<const EmbeddedVoice> ev_sp, int fft_size, int spec_bins,
+               int quality_override = -1);
 
 // UTAUタイムマッピング
 double get_source_ms(const EmbeddedVoice& ev);
@@ -116,15 +247,23 @@ void blend_transition_spectra(
     double** spec_prev, double** ap_prev, int prev_len,
     int spec_bins, int transition_frames);
 
+// ポストEQ (WORLD出力の金属的倍音・箱鳴り補正、高域補強)
+void apply_post_eq(double* y, int y_length);
+
 // F0 DSP
 void smooth_f0_gaussian(double* f0, int f0_length);
+// depth_curve / rate_curve は prepare_curves で f0_length に展開済み
 void apply_vibrato(double* f0, int f0_length, double frame_period_ms,
                    double global_time_offset_sec,
                    const double* depth_curve,
-                   const double* rate_curve,
-                   int curve_length);
+                   const double* rate_curve);
 
 // ノート合成 (execute_render / synth_loop 共通)
+// ポインタ版: 呼び出し側が pp.note_samples 分の書き込み先を用意する
+// （execute_render はセッション所有のアリーナから切り出す）。
+// ゼロ初期化は不要 — VOSE_Synthesis が出力を先頭でゼロクリアする。
+void synthesize_note_impl(const SynthNoteParams& p, double* note_buf);
+// vector 版: resize して上に委譲する（ストリーミング / セグメント用）
 void synthesize_note_impl(const SynthNoteParams& p, std::vector<double>& note_buf);
 
 // 定数
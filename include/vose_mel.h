@@ -0,0 +1,27 @@
+// vose_mel.h
+// ============================================================
+// BigVGAN 用メルスペクトログラム フロントエンド
+//
+// WORLD 出力 PCM を BigVGAN 学習時と同じログメル表現に変換する。
+// 実装は world/fft.h の大浦版 rdft（ip/w テーブル事前計算済み）を
+// スレッドごとに1プラン使い回し、フレームループをワーカープールで
+// 並列化する。詳細は src/vose_mel.cpp を参照。
+//
+// ONNX Runtime には依存しないため、無印版ビルドでもコンパイルされる
+// （呼び出しは VOSE_PRO の BigVGAN 分岐からのみ）。
+// ============================================================
+#pragma once
+
+#include <vector>
+
+// BigVGAN 学習時の標準パラメータ (44.1kHz)
+constexpr int kMelNFft  = 1024;   // STFT 窓長
+constexpr int kMelHop   = 256;    // ホップ長 [サンプル]
+constexpr int kMelBands = 80;     // メルバンド数
+
+// pcm ([-1,1] 正規化済み float) からログメルスペクトログラムを計算する。
+// 出力は mel[t * kMelBands + m] のフレーム行優先フラット配列
+// （必要サイズに assign される）。
+// 戻り値: フレーム数 = (n_samples + kMelHop - 1) / kMelHop
+int compute_mel_spectrogram(const float* pcm, int n_samples,
+                            std::vector<float>& mel);
@@ -37,6 +37,9 @@
 // ストリーミングセッションの不透明ハンドル
 typedef void* VoseStreamHandle;
 
+// マルチトラックミキサーの不透明ハンドル
+typedef void* VoseMixerHandle;
+
 // ストリーミング設定
 struct VoseStreamConfig {
     int    sample_rate;          // 出力サンプルレート (通常 44100)
@@ -87,14 +90,81 @@ DLLEXPORT void streaming_render_push_note(VoseStreamHandle h,
 DLLEXPORT int  streaming_render_pull(VoseStreamHandle h,
                                      float* out_buf, int max_samples);
 
+// ゼロコピー読み出し (pull の代替)
+// リング内部の連続領域を最大2つ返す（折り返しをまたぐ場合のみ第2
+// セグメントが非空）。オーディオコールバックはこのポインタを直接
+// デバイスバッファに渡すか、その場でミックスできる。
+// 消費したサンプル数を streaming_render_commit で確定するまで、
+// 返した領域は合成スレッドに上書きされない。
+// 戻り値: 読み出し可能な総サンプル数 (= *n1 + *n2)
+DLLEXPORT int  streaming_render_acquire(VoseStreamHandle h,
+                                        const float** p1, int* n1,
+                                        const float** p2, int* n2);
+
+// acquire で読んだ分を確定する (n <= *n1 + *n2 であること)
+DLLEXPORT void streaming_render_commit(VoseStreamHandle h, int n);
+
 // 現在の先行バッファ残量 [ms] を返す
 // この値が buffer_ms を上回るまでは pull で0が返る
 DLLEXPORT double streaming_render_buffered_ms(VoseStreamHandle h);
 
+// 品質ガバナーの現在ティアを返す (GUI のインジケーター用)
+//   0 = フル品質
+//   1 = ポストEQ省略
+//   2 = + 帯気変調省略（D4C の ap をそのまま使用）
+//   3 = + Dio 解析ティアへフォールバック
+// 合成スレッドがバッファ残量と実時間係数 (RTF) を監視して自動で
+// 昇降する。縮退した音はアンダーランの無音より常にマシ、が方針。
+DLLEXPORT int  streaming_render_quality_tier(VoseStreamHandle h);
+
 // テンポをリアルタイム変更 (次ノートの合成から反映)
 DLLEXPORT void streaming_render_set_tempo(VoseStreamHandle h, float bpm);
 
 // セッション破棄 (合成スレッドを安全に停止)
 DLLEXPORT void streaming_render_destroy(VoseStreamHandle h);
 
+// ============================================================
+// マルチトラックミキサー
+//
+// ハーモニースタック用。各トラックは独立した NoteQueue と合成
+// スレッドを持つ通常のストリーミングセッションで、ミキサーは
+// C++ 側で加算段（ゲイン/パン付きステレオミックスダウン）だけを
+// 追加する。Python 側でトラックごとに pull して足す方式に比べ、
+// コールバックあたりのコピーと GIL 往復がトラック数ぶん消える。
+// ============================================================
+
+// ミキサー作成。config は全トラックに共通適用される
+DLLEXPORT VoseMixerHandle streaming_mixer_create(const VoseStreamConfig* config);
+
+// トラック追加。返るハンドルは streaming_render_push_note /
+// streaming_render_set_tempo 等にそのまま渡せる。
+// トラックはミキサーが所有するため streaming_render_destroy を
+// 呼んではならない（streaming_mixer_destroy が全トラックを解放する）
+DLLEXPORT VoseStreamHandle streaming_mixer_add_track(VoseMixerHandle mixer);
+
+// トラックごとのゲイン (リニア、デフォルト 1.0)
+DLLEXPORT void streaming_mixer_set_track_gain(VoseMixerHandle mixer,
+                                              VoseStreamHandle track,
+                                              float gain);
+
+// トラックごとのパン (-1.0 = 左, 0.0 = 中央, +1.0 = 右。等パワー則)
+DLLEXPORT void streaming_mixer_set_track_pan(VoseMixerHandle mixer,
+                                             VoseStreamHandle track,
+                                             float pan);
+
+// ステレオミックスダウンを取り出す
+// out_lr     : インターリーブ L,R (容量 2 * max_frames の float[])
+// max_frames : 取り出す最大フレーム数
+// 戻り値     : 実際に書き込んだフレーム数
+//              全トラックの残量の最小値まで — 1本でも合成が追いついて
+//              いなければ 0 が返る（トラック間のサンプル整合を保証）
+DLLEXPORT int  streaming_mixer_pull(VoseMixerHandle mixer,
+                                    float* out_lr, int max_frames);
+
+// 全トラックの先行バッファ残量の最小値 [ms]
+DLLEXPORT double streaming_mixer_buffered_ms(VoseMixerHandle mixer);
+
+// ミキサー破棄 (全トラックの合成スレッドを停止・解放)
+DLLEXPORT void streaming_mixer_destroy(VoseMixerHandle mixer);
+
 } // extern "C"
@@ -0,0 +1,185 @@
+// vose_thread_pool.h
+// ============================================================
+// WorkStealingPool — エンジン全域で共有する永続ワーカープール
+//
+// 背景:
+//   execute_render のパス2-A は従来「1ノート=1 std::thread を生成し、
+//   hardware_concurrency 個ずつバッチで join」していた。
+//   この方式には2つのコストがある:
+//     1. ノートごとのスレッド生成/破棄（500ノート曲で500回）
+//     2. バッチバリア — バッチ内の最長ノートが終わるまで
+//        他の全コアがアイドルになる（混在ノート長で顕著）
+//
+// 解決:
+//   ライブラリ内に常駐するワーカープールを一度だけ生成し、
+//   以後すべてのレンダリングでタスク投入のみ行う。
+//   - ワーカーごとに専用 deque を持ち、自分のキューが空いたら
+//     他ワーカーのキュー末尾から盗む（work stealing）
+//     → 長いノートを引いたワーカー以外が残タスクを消化し続ける
+//   - tl_scratch は thread_local なのでワーカー間の競合はない
+//
+// 使い方:
+//   TaskGroup tg;
+//   for (...) tg.run(vose_worker_pool(), [&]{ ... });
+//   tg.wait();   // 全タスク完了までブロック
+// ============================================================
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    WorkStealingPool() {
+        const int n = static_cast<int>(
+            std::max(1u, std::thread::hardware_concurrency()));
+        queues_.reserve(n);
+        for (int i = 0; i < n; ++i)
+            queues_.emplace_back(new WorkerQueue());
+        workers_.reserve(n);
+        for (int i = 0; i < n; ++i)
+            workers_.emplace_back([this, i] { worker_main(i); });
+    }
+
+    ~WorkStealingPool() {
+        {
+            // sleep_mu_ を取ってからフラグを立てる（submit と同じ理由。
+            // 述語評価とブロックの隙間に notify が落ちると join が止まる）
+            std::lock_guard<std::mutex> lk(sleep_mu_);
+            stop_.store(true);
+        }
+        sleep_cv_.notify_all();
+        for (auto& t : workers_)
+            if (t.joinable()) t.join();
+    }
+
+    // タスク投入（どのスレッドから呼んでも安全）
+    // ラウンドロビンで各ワーカーのキューへ分配する
+    void submit(Task task) {
+        const size_t idx =
+            next_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+        {
+            std::lock_guard<std::mutex> lk(queues_[idx]->mu);
+            queues_[idx]->dq.push_back(std::move(task));
+        }
+        {
+            // pending_ の加算は sleep_mu_ の下で行う。ワーカーは同じ
+            // ミューテックスの下で待機述語を評価するため、ロック外で
+            // 加算+notify すると「述語チェック（pending_==0）とブロックの
+            // 間」に通知が落ちて消える（lost wakeup）。全ワーカーが寝た
+            // 状態の最後の submit でそれが起きるとタスクが放置され、
+            // TaskGroup::wait が次の submit まで（ストリーミングでは
+            // 永久に）ハングする。
+            std::lock_guard<std::mutex> lk(sleep_mu_);
+            pending_.fetch_add(1, std::memory_order_release);
+        }
+        sleep_cv_.notify_one();
+    }
+
+    int worker_count() const { return static_cast<int>(workers_.size()); }
+
+private:
+    struct WorkerQueue {
+        std::mutex       mu;
+        std::deque<Task> dq;
+    };
+
+    void worker_main(int self) {
+        Task task;
+        for (;;) {
+            if (try_pop(self, task)) {
+                // タスク内の例外でワーカーを死なせない
+                try { task(); } catch (...) {}
+                task = nullptr;
+                continue;
+            }
+            std::unique_lock<std::mutex> lk(sleep_mu_);
+            sleep_cv_.wait(lk, [this] {
+                return stop_.load() ||
+                       pending_.load(std::memory_order_acquire) > 0;
+            });
+            if (stop_.load() &&
+                pending_.load(std::memory_order_acquire) == 0)
+                return;
+        }
+    }
+
+    bool try_pop(int self, Task& out) {
+        // 1. 自分のキューの先頭から取る（FIFO: 投入順を尊重）
+        {
+            auto& q = *queues_[self];
+            std::lock_guard<std::mutex> lk(q.mu);
+            if (!q.dq.empty()) {
+                out = std::move(q.dq.front());
+                q.dq.pop_front();
+                pending_.fetch_sub(1, std::memory_order_release);
+                return true;
+            }
+        }
+        // 2. 他ワーカーのキュー末尾から盗む
+        const size_t n = queues_.size();
+        for (size_t k = 1; k < n; ++k) {
+            auto& q = *queues_[(self + k) % n];
+            std::lock_guard<std::mutex> lk(q.mu);
+            if (!q.dq.empty()) {
+                out = std::move(q.dq.back());
+                q.dq.pop_back();
+                pending_.fetch_sub(1, std::memory_order_release);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread>                  workers_;
+    std::mutex              sleep_mu_;
+    std::condition_variable sleep_cv_;
+    std::atomic<bool>       stop_{false};
+    std::atomic<size_t>     pending_{0};
+    std::atomic<uint64_t>   next_{0};
+};
+
+// プロセス共通のプールインスタンス
+// 初回呼び出しで生成され、プロセス終了まで常駐する
+inline WorkStealingPool& vose_worker_pool() {
+    static WorkStealingPool pool;
+    return pool;
+}
+
+// ============================================================
+// TaskGroup — submit したタスク群の完了待ち合わせ
+// ============================================================
+class TaskGroup {
+public:
+    void run(WorkStealingPool& pool, std::function<void()> fn) {
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            ++pending_;
+        }
+        pool.submit([this, fn = std::move(fn)] {
+            fn();
+            std::lock_guard<std::mutex> lk(mu_);
+            if (--pending_ == 0) cv_.notify_all();
+        });
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lk(mu_);
+        cv_.wait(lk, [this] { return pending_ == 0; });
+    }
+
+private:
+    std::mutex              mu_;
+    std::condition_variable cv_;
+    int                     pending_ = 0;
+};
@@ -25,6 +25,43 @@ extern "C" {
 void wavwrite(const double *x, int x_length, int fs, int nbit,
   const char *filename);
 
+//-----------------------------------------------------------------------------
+// WavStreamWriter is an incremental .wav writer: open once, append blocks of
+// doubles as they are produced, and finalize to patch the RIFF sizes.
+// Conversion (clamp + TPDF dither for 16 bit, float32 for 32 bit) happens on
+// the calling thread; the converted bytes are flushed by a background I/O
+// thread, so disk latency overlaps with synthesis instead of following it.
+//-----------------------------------------------------------------------------
+typedef struct WavStreamWriterImpl WavStreamWriter;
+
+//-----------------------------------------------------------------------------
+// OpenWavStreamWriter() creates the writer and writes a provisional header.
+// Input:
+//   filename   : Name of the output file.
+//   fs         : Sampling frequency [Hz]
+//   nbit       : Quantization bit. 16 = PCM with TPDF dither,
+//                32 = IEEE float. Other values fall back to 16.
+// Output:
+//   The writer handle, or NULL if the file cannot be opened.
+//-----------------------------------------------------------------------------
+WavStreamWriter *OpenWavStreamWriter(const char *filename, int fs, int nbit);
+
+//-----------------------------------------------------------------------------
+// AppendWavStreamWriter() converts and queues a block for writing.
+// Input:
+//   writer     : Writer created by OpenWavStreamWriter()
+//   x          : Input signal block
+//   x_length   : Signal length of x [sample]
+//-----------------------------------------------------------------------------
+void AppendWavStreamWriter(WavStreamWriter *writer, const double *x,
+  int x_length);
+
+//-----------------------------------------------------------------------------
+// FinalizeWavStreamWriter() drains the queue, patches the RIFF/data sizes,
+// closes the file and destroys the writer.
+//-----------------------------------------------------------------------------
+void FinalizeWavStreamWriter(WavStreamWriter *writer);
+
 //-----------------------------------------------------------------------------
 // GetAudioLength() returns the length of .wav file.
 // Input:
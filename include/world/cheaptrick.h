@@ -17,6 +17,10 @@ typedef struct {
   double q1;
   double f0_floor;
   int fft_size;
+  // Number of worker threads for the frame loop (0 or 1 = serial).
+  // Each frame is independent, so the spectrogram rows are split
+  // across threads with per-thread FFT work areas.
+  int n_threads;
 } CheapTrickOption;
 
 //-----------------------------------------------------------------------------
@@ -15,6 +15,10 @@ WORLD_BEGIN_C_DECLS
 //-----------------------------------------------------------------------------
 typedef struct {
   double threshold;
+  // Number of worker threads for the frame loop (0 or 1 = serial).
+  // Frames are independent once D4C Love Train has run, so they are
+  // split across threads with per-thread FFT work areas.
+  int n_threads;
 } D4COption;
 
 //-----------------------------------------------------------------------------
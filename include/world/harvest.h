@@ -17,6 +17,10 @@ typedef struct {
   double f0_floor;
   double f0_ceil;
   double frame_period;
+  // Number of worker threads (0 or 1 = serial). The boundary-F0 channel
+  // filtering and the candidate refinement are split across threads;
+  // the result is identical to the serial path.
+  int n_threads;
 } HarvestOption;
 
 //-----------------------------------------------------------------------------
@@ -6,10 +6,44 @@
 #ifndef WORLD_SYNTHESIS_H_
 #define WORLD_SYNTHESIS_H_
 
+#include "world/common.h"
 #include "world/macrodefinitions.h"
+#include "world/matlabfunctions.h"
 
 WORLD_BEGIN_C_DECLS
 
+//-----------------------------------------------------------------------------
+// Struct for SynthesisWithContext
+//
+// Owns the FFT plans (including the Ooura twiddle tables) and all working
+// arrays used by the synthesis loop, so that repeated calls with the same
+// fft_size avoid the per-call setup/teardown and heap traffic of Synthesis().
+// Create one per thread; the context is not thread-safe.
+//-----------------------------------------------------------------------------
+typedef struct {
+  int fft_size;
+  ForwardRealFFT forward_real_fft;
+  InverseRealFFT inverse_real_fft;
+  MinimumPhaseAnalysis minimum_phase;
+  RandnState randn_state;
+
+  // Scratch of fft_size elements (dc_remover depends only on fft_size and is
+  // computed once at initialization).
+  double *impulse_response;
+  double *dc_remover;
+  double *spectral_envelope;
+  double *aperiodic_ratio;
+  double *periodic_response;
+  double *aperiodic_response;
+
+  // Scratch grown on demand to the largest y_length seen so far.
+  double *pulse_locations;
+  int *pulse_locations_index;
+  double *pulse_locations_time_shift;
+  double *interpolated_vuv;
+  int reserved_y_length;
+} SynthesisContext;
+
 //-----------------------------------------------------------------------------
 // Synthesis() synthesize the voice based on f0, spectrogram and
 // aperiodicity (not excitation signal).
@@ -27,10 +61,45 @@ WORLD_BEGIN_C_DECLS
 // Output:
 //   y                    : Calculated speech
 //-----------------------------------------------------------------------------
-void Synthesis(const double *f0, int f0_length, 
-    const double * const *spectrogram, const double * const *aperiodicity, 
+void Synthesis(const double *f0, int f0_length,
+    const double * const *spectrogram, const double * const *aperiodicity,
     int fft_size, double frame_period, int fs, int y_length, double *y);
 
+//-----------------------------------------------------------------------------
+// InitializeSynthesisContext() allocates the plans and buffers for the given
+// fft_size and seeds the noise generator.
+//
+// Input:
+//   fft_size             : FFT size
+//
+// Output:
+//   context              : Struct holding the reusable synthesis state
+//-----------------------------------------------------------------------------
+void InitializeSynthesisContext(int fft_size, SynthesisContext *context);
+
+//-----------------------------------------------------------------------------
+// SynthesisWithContext() is Synthesis() reusing a prepared context.
+// The output is identical to Synthesis(); only the allocation behavior
+// differs. If fft_size does not match the context, the context is rebuilt
+// transparently.
+//
+// Input:
+//   context              : Context prepared by InitializeSynthesisContext()
+//   (remaining arguments as for Synthesis())
+//
+// Output:
+//   y                    : Calculated speech
+//-----------------------------------------------------------------------------
+void SynthesisWithContext(SynthesisContext *context, const double *f0,
+    int f0_length, const double * const *spectrogram,
+    const double * const *aperiodicity, int fft_size, double frame_period,
+    int fs, int y_length, double *y);
+
+//-----------------------------------------------------------------------------
+// DestroySynthesisContext() frees everything owned by the context.
+//-----------------------------------------------------------------------------
+void DestroySynthesisContext(SynthesisContext *context);
+
 WORLD_END_C_DECLS
 
 #endif  // WORLD_SYNTHESIS_H_
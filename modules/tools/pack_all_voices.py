@@ -2,6 +2,8 @@ import wave
 import numpy as np
 import glob
 import os
+import struct
+import sys
 
 def pack_all_voices():
     #output_path = "src/voice_data.h"
@@ -100,5 +102,99 @@ def pack_all_voices():
 
     print(f"Success: Packed {len(wav_files)} voices from {search_path}")
 
+
+def read_wav_as_int16(wav_path):
+    """wav を 44100Hz モノラル int16 の np.array に正規化して返す"""
+    with wave.open(wav_path, 'rb') as f:
+        fs = f.getframerate()
+        nch = f.getnchannels()
+        frames = f.readframes(f.getnframes())
+        data = np.frombuffer(frames, dtype=np.int16)
+
+        if nch == 2:
+            data = data[::2]
+
+        if fs != 44100:
+            from scipy.signal import resample_poly
+            from math import gcd
+            g = gcd(fs, 44100)
+            resampled = resample_poly(data, 44100 // g, fs // g)
+            resampled = np.clip(resampled, -32768, 32767)
+            data = resampled.astype(np.int16)
+    return data
+
+
+def pack_voicebank():
+    """パック音源バンク (.vpk) 形式で出力する (--vpk)
+
+    C配列ヘッダの代わりに単一ファイル
+    「VoseBankHeader + VoseBankEntry[] + 連結 int16 PCM」を書き、
+    voice_data.h は load_voicebank_pack() を呼ぶだけになる。
+    エンジン側は .vpk を mmap してビュー登録するので、
+    起動時のコピーも double 展開も発生しない。
+    レイアウトは include/vose_core.h の定義と一致させること
+    (ヘッダ16バイト・エントリ80バイト・リトルエンディアン)。
+    """
+    base_dir = os.path.abspath(os.path.join(os.path.dirname(__file__), "../../"))
+    header_path = os.path.join(base_dir, "src/voice_data.h")
+    vpk_path = os.path.join(base_dir, "bin/official_voices.vpk")
+    search_path = os.path.join(base_dir, "assets/official_voices/**/*.wav")
+
+    os.makedirs(os.path.dirname(header_path), exist_ok=True)
+    os.makedirs(os.path.dirname(vpk_path), exist_ok=True)
+
+    wav_files = glob.glob(search_path, recursive=True)
+    print(f"Target Output: {vpk_path}")
+    print(f"Searching in: {search_path}")
+
+    entries = []       # (entry_name, sample_offset, sample_count)
+    pcm_blocks = []
+    sample_offset = 0
+
+    for wav_path in wav_files:
+        parts = os.path.normpath(wav_path).split(os.sep)
+        folder_name = parts[-2] if len(parts) > 2 else ""
+        file_base = os.path.splitext(parts[-1])[0]
+        entry_name = f"{folder_name}_{file_base}" if folder_name != "official_voices" else file_base
+
+        alias = entry_name.encode('utf-8')
+        if len(alias) > 63:
+            print(f"Error skipping {wav_path}: alias longer than 63 bytes")
+            continue
+
+        try:
+            data = read_wav_as_int16(wav_path)
+        except Exception as e:
+            print(f"Error skipping {wav_path}: {e}")
+            continue
+
+        entries.append((alias, sample_offset, len(data)))
+        pcm_blocks.append(data.astype('<i2').tobytes())
+        sample_offset += len(data)
+
+    with open(vpk_path, 'wb') as f:
+        # VoseBankHeader: magic 'VOSB', version 1
+        f.write(struct.pack("<IIII", 0x42534F56, 1, len(entries), 0))
+        for alias, offset, count in entries:
+            f.write(alias.ljust(64, b'\0'))
+            f.write(struct.pack("<IIII", offset, count, 44100, 0))
+        for block in pcm_blocks:
+            f.write(block)
+
+    # voice_data.h は .vpk を mmap 登録するだけの薄い実装になる
+    with open(header_path, 'w', encoding='utf-8') as h:
+        h.write("#pragma once\n#include <stdint.h>\n\n")
+        h.write('extern "C" int load_voicebank_pack(const char* path);\n\n')
+        h.write("// official_voices.vpk は実行バイナリと同じディレクトリ (bin/) に配置する\n")
+        h.write("inline void register_all_embedded_voices() {\n")
+        h.write('    load_voicebank_pack("official_voices.vpk");\n')
+        h.write("}\n")
+
+    print(f"Success: Packed {len(entries)} voices into {vpk_path}")
+
+
 if __name__ == "__main__":
-    pack_all_voices()
+    if "--vpk" in sys.argv:
+        pack_voicebank()
+    else:
+        pack_all_voices()
@@ -13,12 +13,14 @@ constexpr const T& clamp(const T& v, const T& lo, const T& hi) {
 #include <unordered_map>
 #include <list>
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <sys/stat.h>
 #include <fstream>
 #include <iomanip>    
 #include <random>
 #include <sstream>
+#include <cctype>
 #include <cstring>
 #include <cstdint>
 #include <future>
@@ -26,6 +28,8 @@ constexpr const T& clamp(const T& v, const T& lo, const T& hi) {
 #include <mutex>
 #include <condition_variable>
 #include <memory>
+#include <atomic>
+#include <chrono>
 
 // 先に型定義を完了させ、ONNXセッション側での未定義エラーを防ぐ
 using VoseMutex = std::mutex;
@@ -41,6 +45,13 @@ using VoseUniqueLock = std::unique_lock<std::mutex>;
 #  define mkdir(path, mode) _mkdir(path) // 2引数版をWindows用に1引数ラップ
 #else
 #  include <unistd.h>
+#  include <fcntl.h>
+#  include <sys/mman.h>   // ディスクキャッシュの mmap ロード用
+#endif
+
+#if defined(_WIN32) || defined(_WIN64)
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>    // CreateFileMapping / MapViewOfFile
 #endif
 
 // _USE_MATH_DEFINES の再定義警告(C4005)および未定義対策
@@ -59,6 +70,8 @@ static VoseMutex                     g_bigvgan_mutex; // 前方で定義済み
 #endif
 
 #include "vose_core.h"
+#include "vose_mel.h"
+#include "vose_thread_pool.h"
 #include "voice_data.h"
 // ...existing code...
 
@@ -66,6 +79,8 @@ static VoseMutex                     g_bigvgan_mutex; // 前方で定義済み
 #include "world/cheaptrick.h"
 #include "world/d4c.h"
 #include "world/harvest.h"
+#include "world/dio.h"
+#include "world/stonemask.h"
 #include "world/audioio.h"
 #include "world/constantnumbers.h"
 
@@ -84,6 +99,17 @@ static uint64_t fnv1a_hash(const std::string& str) {
     return hash;
 }
 
+// C文字列版（ルックアップ時の std::string 構築を避ける）。
+// 符号拡張まで含めて std::string 版と同じ値を返すこと
+static uint64_t fnv1a_hash(const char* str) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (; *str; ++str) {
+        hash ^= static_cast<uint64_t>(*str);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
 static std::string generate_cache_hash(const std::string& wav_path) {
     struct stat st;
     if (stat(wav_path.c_str(), &st) == 0) {
@@ -105,42 +131,259 @@ static std::string generate_cache_hash(const std::string& wav_path) {
 }
 
 // ============================================================
-// oto.ini DB
+// FlatSnapshotMap — RCU 風スナップショット辞書
+//
+// execute_render のプリパスと streaming の synth_loop は従来
+// ノートごとに g_oto_db_mutex / g_voice_db_mutex を取っていた。
+// 並列プリウォームやマルチトラックストリーミングでは純粋な読み取り
+// 同士でロックが競合する。そこで辞書を不変スナップショットにし、
+// 読み手は shared_ptr を1回取得して以降ロックなしで参照する。
+// 書き手は現行スナップショットをコピーした新しいマップを構築し、
+// std::atomic_store で差し替える（copy-on-write）。
+//
+// テーブルは2冪サイズ + 線形探索のフラット配列で、キーは
+// fnv1a_hash の64bit値。探索はハッシュ比較だけで進み、文字列比較は
+// ハッシュ一致時の最終確認1回に限られる。
+// ============================================================
+template <typename Value>
+struct FlatSnapshotMap {
+    struct Slot {
+        uint64_t    hash = 0;
+        bool        used = false;
+        std::string key;
+        Value       value{};
+    };
+    std::vector<Slot> slots;
+    size_t            count = 0;
+
+    FlatSnapshotMap() : slots(16) {}
+
+    const Value* find(const char* key) const {
+        if (!key) return nullptr;
+        const uint64_t h    = fnv1a_hash(key);
+        const size_t   mask = slots.size() - 1;
+        for (size_t i = h & mask; slots[i].used; i = (i + 1) & mask)
+            if (slots[i].hash == h && slots[i].key == key)
+                return &slots[i].value;
+        return nullptr;
+    }
+
+    // 書き手専用。公開（atomic_store）前の構築中にのみ呼ぶこと
+    void insert(const std::string& key, Value value) {
+        // 負荷率 3/4 でリハッシュ（find の探索が空きスロットで必ず止まる）
+        if ((count + 1) * 4 >= slots.size() * 3) rehash(slots.size() * 2);
+        insert_slot(fnv1a_hash(key), key, std::move(value));
+    }
+
+    template <typename F>
+    void for_each(F&& f) const {
+        for (const Slot& s : slots)
+            if (s.used) f(s.key, s.value);
+    }
+
+private:
+    void insert_slot(uint64_t h, const std::string& key, Value value) {
+        const size_t mask = slots.size() - 1;
+        size_t i = h & mask;
+        while (slots[i].used) {
+            if (slots[i].hash == h && slots[i].key == key) {
+                slots[i].value = std::move(value);   // 同キーは上書き
+                return;
+            }
+            i = (i + 1) & mask;
+        }
+        slots[i].hash  = h;
+        slots[i].used  = true;
+        slots[i].key   = key;
+        slots[i].value = std::move(value);
+        ++count;
+    }
+
+    void rehash(size_t new_size) {
+        std::vector<Slot> old = std::move(slots);
+        slots.assign(new_size, Slot());
+        count = 0;
+        for (Slot& s : old)
+            if (s.used) insert_slot(s.hash, s.key, std::move(s.value));
+    }
+};
+
+// ============================================================
+// oto.ini DB（RCU 風スナップショット）
 // ============================================================
 
-std::map<std::string, OtoEntry> g_oto_db;
+using OtoMap = FlatSnapshotMap<OtoEntry>;
+
+// 現行スナップショット。読み手は oto_snapshot() 経由で取得する。
+// ミューテックスは書き手の copy-modify-publish の直列化にだけ使う
+static std::shared_ptr<const OtoMap> g_oto_db_store =
+    std::make_shared<const OtoMap>();
 VoseMutex g_oto_db_mutex;
 
+std::shared_ptr<const OtoMap> oto_snapshot() {
+    return std::atomic_load_explicit(&g_oto_db_store,
+                                     std::memory_order_acquire);
+}
+
 extern "C" void set_oto_data(const OtoEntry* entries, int count) {
+    auto next = std::make_shared<OtoMap>();
+    if (entries && count > 0)
+        for (int i = 0; i < count; ++i)
+            next->insert(entries[i].alias, entries[i]);
+
     VoseUniqueLock lock(g_oto_db_mutex);
-    g_oto_db.clear();
-    if (!entries || count <= 0) return;
-    for (int i = 0; i < count; ++i)
-        g_oto_db[entries[i].alias] = entries[i];
+    std::atomic_store_explicit(&g_oto_db_store,
+        std::shared_ptr<const OtoMap>(std::move(next)),
+        std::memory_order_release);
 }
 
 // ============================================================
 // データ構造
 // ============================================================
 
+struct MmapFile;  // 定義は下（ディスクキャッシュの mmap と共用）
+
+// 波形は int16 のまま保持し、double への変換は解析の初回タッチまで
+// 遅延する。ソースは「所有ベクタ (load_embedded_resource)」または
+// 「.vpk の mmap ビュー (load_voicebank_pack)」のどちらか。
+// double 波形を常駐させない（decode_waveform はローカルに返す）ため、
+// 登録だけして使われない音素の常駐メモリは raw int16 ぶんで済む。
 struct EmbeddedVoice {
-    std::string         path;
-    std::vector<double> waveform;
-    int                 fs;
+    std::string path;
+    int         fs = 44100;
+
+    std::vector<int16_t>      raw_store;            // 所有コピー
+    const int16_t*            raw_view   = nullptr; // mmap ビュー
+    int                       raw_length = 0;
+    std::shared_ptr<MmapFile> raw_map;              // ビューの寿命保持
+
+    int            length()   const { return raw_length; }
+    const int16_t* raw_data() const {
+        return raw_view ? raw_view : raw_store.data();
+    }
+
+    // int16 → double デコード。Harvest/CheapTrick/D4C の入力にだけ
+    // 必要なので呼び出し側のローカルに持たせ、解析後に解放する。
+    std::vector<double> decode_waveform() const {
+        std::vector<double> w(raw_length);
+        const int16_t* src = raw_data();
+        for (int i = 0; i < raw_length; ++i)
+            w[i] = static_cast<double>(src[i]) * (1.0 / 32768.0);
+        return w;
+    }
 };
 
-static std::map<std::string, std::shared_ptr<const EmbeddedVoice>> g_voice_db;
-VoseMutex g_voice_db_mutex;
+// ボイスDBも oto と同じスナップショット方式。
+// 値が shared_ptr なので find_voice_ref はコピー1回で済む
+using VoiceMap = FlatSnapshotMap<std::shared_ptr<const EmbeddedVoice>>;
+
+static std::shared_ptr<const VoiceMap> g_voice_db_store =
+    std::make_shared<const VoiceMap>();
+VoseMutex g_voice_db_mutex;   // 書き手の copy-modify-publish 直列化用
+
+std::shared_ptr<const VoiceMap> voice_snapshot() {
+    return std::atomic_load_explicit(&g_voice_db_store,
+                                     std::memory_order_acquire);
+}
+
+// ============================================================
+// MmapFile — ディスクキャッシュの読み取り専用メモリマップ
+//
+// .vsf / .vsc は「固定ヘッダ + 連続配列」のフラット形式なので、
+// ifstream::read で数GBをページキャッシュ経由でコピーする代わりに
+// mmap してファイル内を直接参照できる。AnalysisCache が
+// shared_ptr<MmapFile> を保持する限りマッピングは生き続け、
+// CacheStore の LRU から追い出された時点で munmap される。
+// ============================================================
+struct MmapFile {
+    const uint8_t* data = nullptr;
+    size_t         size = 0;
+
+#if defined(_WIN32) || defined(_WIN64)
+    void* file_handle = nullptr;   // HANDLE (CreateFileA)
+    void* map_handle  = nullptr;   // HANDLE (CreateFileMappingA)
+#endif
+
+    static std::shared_ptr<MmapFile> open(const std::string& path);
+    ~MmapFile();
+
+    MmapFile() = default;
+    MmapFile(const MmapFile&)            = delete;
+    MmapFile& operator=(const MmapFile&) = delete;
+};
 
+// スペクトル層は v2 表現（log振幅 float32 / AP float32）で保持する。
+// double のままだと1音素あたり約16MBでLRUを圧迫するため、
+// 解析直後に log をとって float32 へ落とし、合成時の
+// copy_cache_to_scratch 境界で exp して double に戻す。
+// log ドメインなら float32 の仮数でもダイナミックレンジを失わない。
+//
+// 各配列は「所有ベクタ」または「mmap ビュー」のどちらかで保持される。
+// 新規解析はベクタに書き、ディスクキャッシュのロードは mmap ビューを
+// 張るだけでコピーしない。読み出し側は必ず *_data() アクセサを使うこと。
 struct AnalysisCache {
     std::vector<double> f0;
     std::vector<double> time;
     int                 length    = 0;
-    std::vector<double> flat_spec;
-    std::vector<double> flat_ap;
+    std::vector<float>  flat_spec;   // log(spectral envelope)
+    std::vector<float>  flat_ap;     // aperiodicity [0,1]
     int                 spec_bins = 0;
+
+    // mmap ビュー（非 null ならベクタではなくこちらを参照）
+    std::shared_ptr<MmapFile> f0_map, spec_map;
+    const double* f0_view   = nullptr;
+    const double* time_view = nullptr;
+    const float*  spec_view = nullptr;
+    const float*  ap_view   = nullptr;
+
+    const double* f0_data()   const { return f0_view   ? f0_view   : f0.data();        }
+    const double* time_data() const { return time_view ? time_view : time.data();      }
+    const float*  spec_data() const { return spec_view ? spec_view : flat_spec.data(); }
+    const float*  ap_data()   const { return ap_view   ? ap_view   : flat_ap.data();   }
+};
+
+// スペクトル値の下限（log にかける前のフロア。exp(-69) ≈ 1e-30）
+static constexpr double kSpecFloor = 1e-30;
+
+static inline float  encode_spec(double v) {
+    return static_cast<float>(std::log(std::max(v, kSpecFloor)));
+}
+static inline double decode_spec(float v) {
+    return std::exp(static_cast<double>(v));
+}
+
+// ============================================================
+// エンジン統計カウンタ (get_engine_stats)
+//
+// vose_core_internal.h の VoseStatsCounters と手動同期。
+// ホットパスでは fetch_add(relaxed) のみで触れるため、計測を
+// 常時有効にしてもキャッシュライン1本分のコストしかかからない。
+// ============================================================
+struct VoseStatsCounters {
+    std::atomic<uint64_t> cache_hits{0};
+    std::atomic<uint64_t> cache_misses{0};
+    std::atomic<uint64_t> cache_evictions{0};
+    std::atomic<uint64_t> disk_load_bytes{0};
+    std::atomic<uint64_t> disk_load_ns{0};
+    std::atomic<uint64_t> disk_save_bytes{0};
+    std::atomic<uint64_t> disk_save_ns{0};
+    std::atomic<uint64_t> synth_notes{0};
+    std::atomic<uint64_t> synth_spectral_ns{0};
+    std::atomic<uint64_t> synth_f0_ns{0};
+    std::atomic<uint64_t> synth_world_ns{0};
+    std::atomic<uint64_t> synth_posteq_ns{0};
+    std::atomic<uint64_t> stream_underruns{0};
 };
 
+VoseStatsCounters g_engine_stats;
+
+// ステージ計測用の経過ナノ秒（steady_clock ベース）
+static inline uint64_t stats_now_ns() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
 // ============================================================
 // AnalysisCacheStore — LRU エビクション付きメモリキャッシュ
 //
@@ -155,7 +398,9 @@ struct AnalysisCache {
 // VO-SE専用の型定義（既存の定義に合わせて調整してください）
 struct AnalysisCache; 
 
-static constexpr size_t kMaxCacheEntries = 64; // 約1GB上限（16MB × 64）
+// v2 キャッシュ（float32）でエントリが約8MBに半減したため、
+// 同じ約1GB予算で128エントリ保持できる（200音素バンクの大半をカバー）
+static constexpr size_t kMaxCacheEntries = 128; // 約1GB上限（8MB × 128）
 
 struct CacheStore {
     using Key   = std::string;
@@ -187,10 +432,11 @@ public:
         // キャッシュ溢れ時の追い出し処理（バグ修正版）
         while (index.size() > kMaxCacheEntries) {
             // 参照ではなく、値を完全にコピーしてローカルに退避させる
-            const Key old_key = lru_list.back().first; 
-            
+            const Key old_key = lru_list.back().first;
+
             index.erase(old_key);
             lru_list.pop_back(); // ここでリストから消えても old_key は生きているので安全
+            g_engine_stats.cache_evictions.fetch_add(1, std::memory_order_relaxed);
         }
     }
 
@@ -223,6 +469,15 @@ public:
         std::lock_guard<std::mutex> lock(mtx);
         return index.size();
     }
+
+    // セッションマニフェスト用: 保持中のキーを MRU 順で返す
+    std::vector<Key> keys() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        std::vector<Key> out;
+        out.reserve(index.size());
+        for (const auto& kv : lru_list) out.push_back(kv.first);
+        return out;
+    }
 };
 
 // グローバルインスタンス（内部でロックされるため、外部での個別ミューテックス制御は不要になります）
@@ -266,6 +521,11 @@ struct NotePrepass {
 struct SynthesisScratchPad {
     // 平坦化（1次元化）された動的バッファ
     std::vector<double>  flat_spec, flat_ap, spec_tmp;
+
+    // 直近に展開したキャッシュ行（DSP未適用の素の状態）。
+    // 同じソースフレームが連続する区間（ロングトーン）では
+    // exp 展開を1回で済ませ、以降は memcpy / 行共有で供給する。
+    std::vector<double>  spec_base, ap_base;
     std::vector<double*> spec_ptrs, ap_ptrs;
     
     std::vector<double>  f0, time_axis;
@@ -307,6 +567,8 @@ struct SynthesisScratchPad {
             flat_spec     .resize(total); 
             flat_ap       .resize(total);
             spec_tmp      .resize(reserved_bins);
+            spec_base     .resize(reserved_bins);
+            ap_base       .resize(reserved_bins);
             flat_spec_prev.resize(total); 
             flat_ap_prev  .resize(total);
             flat_mod_ap   .resize(total);
@@ -333,6 +595,18 @@ struct SynthesisScratchPad {
         }
     }
 
+    /**
+     * @brief VOSE_Synthesis 用に mod_ap の行ポインタだけを保証する。
+     *        spec_ptrs / ap_ptrs は呼び出し側が行共有のために再配線して
+     *        いる可能性があるため、ここでは一切触らない。
+     */
+    void ensure_mod_ap(int f0_length, int spec_bins) {
+        if (f0_length > reserved_f0 || spec_bins > reserved_bins)
+            ensure_spec(f0_length, spec_bins);  // 容量拡張（共有設定前のみ発生）
+        for (int i = 0; i < f0_length; ++i)
+            mod_ap_ptrs[i] = &flat_mod_ap[static_cast<size_t>(i) * reserved_bins];
+    }
+
     /**
      * @brief 2次元配列風に安全にアクセスするためのユーティリティ（デバッグ・安全用）
      * 外部で `spec_ptrs[i][j]` と書く代わりに `at_spec(i, j)` を使うことで、
@@ -344,17 +618,79 @@ struct SynthesisScratchPad {
 
     void ensure_f0(int n) {
         if (n > static_cast<int>(f0.size())) {
-            f0.resize(n); 
+            f0.resize(n);
             time_axis.resize(n);
         }
     }
 
     void ensure_f0_prev(int n) {
         if (n > static_cast<int>(f0_prev.size())) {
-            f0_prev.resize(n); 
+            f0_prev.resize(n);
             time_axis_prev.resize(n);
         }
     }
+
+    // ノート単位で一括リサンプリング済みの制御カーブ（長さ output_frames）。
+    // f0 はピッチカーブの展開先を兼ねる。
+    std::vector<double> gender_c, tension_c, breath_c;
+    std::vector<double> vib_depth_c, vib_rate_c;
+    bool has_vib_depth = false, has_vib_rate = false;
+
+    /**
+     * @brief 単一スイープ版カーブリサンプラ（resample_curve と同値）
+     *
+     * フレーム毎の除算を避け、ステップ加算だけで src インデックスを進める。
+     * src_len == dst_len は純粋コピー（密なオートメーションの高速路）。
+     */
+    static void resample_batch(const double* curve, int src_len,
+                               double* dst, int dst_len, double fill) {
+        if (dst_len <= 0) return;
+        if (!curve || src_len <= 0) { std::fill_n(dst, dst_len, fill);     return; }
+        if (src_len == 1)           { std::fill_n(dst, dst_len, curve[0]); return; }
+        if (src_len == dst_len)     { std::copy_n(curve, src_len, dst);    return; }
+        const double step =
+            static_cast<double>(src_len - 1) / std::max(dst_len - 1, 1);
+        double src_f = 0.0;
+        for (int j = 0; j < dst_len; ++j, src_f += step) {
+            const int j0 = static_cast<int>(src_f);
+            if (j0 >= src_len - 1) { dst[j] = curve[src_len - 1]; continue; }
+            const double frac = src_f - j0;
+            dst[j] = (1.0 - frac) * curve[j0] + frac * curve[j0 + 1];
+        }
+    }
+
+    /**
+     * @brief ノートの全制御カーブを一括リサンプリングする
+     *
+     * 旧来は step-1 ループがフレーム毎に resample_curve を4回呼び、
+     * 同じインデックス計算（除算込み）を繰り返していた。ここで
+     * ノート先頭に1回の線形スイープへ畳み、下流のDSPループを
+     * unit-stride の配列読みにする。
+     */
+    void prepare_curves(const NoteEvent& n, int output_frames) {
+        ensure_f0(output_frames);
+        const size_t need = static_cast<size_t>(output_frames);
+        if (gender_c.size() < need) {
+            gender_c   .resize(need);
+            tension_c  .resize(need);
+            breath_c   .resize(need);
+            vib_depth_c.resize(need);
+            vib_rate_c .resize(need);
+        }
+        resample_batch(n.pitch_curve,   n.pitch_length, f0.data(),        output_frames, 440.0);
+        resample_batch(n.gender_curve,  n.pitch_length, gender_c.data(),  output_frames, 0.5);
+        resample_batch(n.tension_curve, n.pitch_length, tension_c.data(), output_frames, 0.5);
+        resample_batch(n.breath_curve,  n.pitch_length, breath_c.data(),  output_frames, 0.5);
+
+        has_vib_depth = n.vibrato_depth_curve && n.vibrato_curve_length > 0;
+        has_vib_rate  = n.vibrato_rate_curve  && n.vibrato_curve_length > 0;
+        if (has_vib_depth)
+            resample_batch(n.vibrato_depth_curve, n.vibrato_curve_length,
+                           vib_depth_c.data(), output_frames, 1.0);
+        if (has_vib_rate)
+            resample_batch(n.vibrato_rate_curve,  n.vibrato_curve_length,
+                           vib_rate_c.data(),  output_frames, 6.0);
+    }
 };
 
 // スレッドローカルなインスタンス宣言
@@ -381,9 +717,10 @@ static int64_t note_samples_safe(int p) {
 
 std::shared_ptr<const EmbeddedVoice> find_voice_ref(const char* key)
 {
-    VoseUniqueLock lock(g_voice_db_mutex);
-    auto it = g_voice_db.find(key ? key : "");
-    return (it != g_voice_db.end()) ? it->second : nullptr;
+    if (!key) return nullptr;
+    const auto snap = voice_snapshot();
+    const auto* p   = snap->find(key);
+    return p ? *p : nullptr;
 }
 
 // ============================================================
@@ -399,156 +736,433 @@ static std::string get_cache_dir() {
     return p;
 }
 
-static void save_cache(const std::string& cache_path, const AnalysisCache& cache)
+// ------------------------------------------------------------
+// 2層キャッシュ構成
+//
+// 従来は f0/time/spec/ap を1つの .vsc に格納していたため、
+// fft_size 変更（サンプルレートや CheapTrick オプション変更）で
+// spec_bins が不一致になると、fft_size に依存しない Harvest の
+// F0トラックまで捨てて全再解析になっていた。
+// Harvest が build_analysis_cache の支配的コストなので、
+// F0層とスペクトル層をファイルごと分離する:
+//
+//   <hash>.vsf            … F0層 (time + f0)。fft_size 非依存
+//   <hash>_b<bins>.vsc    … スペクトル層 (flat_spec + flat_ap)。
+//                           spec_bins をファイル名に含むため、
+//                           異なる fft_size のキャッシュが共存できる
+//
+// 旧形式の <hash>.vsc は読まれなくなるが、一度の再解析で
+// 新形式に移行されるだけなので互換コードは持たない。
+// ------------------------------------------------------------
+
+// ------------------------------------------------------------
+// MmapFile 実装（POSIX: mmap / Windows: CreateFileMapping）
+// ------------------------------------------------------------
+
+std::shared_ptr<MmapFile> MmapFile::open(const std::string& path)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    HANDLE fh = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fh == INVALID_HANDLE_VALUE) return nullptr;
+
+    LARGE_INTEGER sz;
+    if (!GetFileSizeEx(fh, &sz) || sz.QuadPart <= 0) {
+        CloseHandle(fh);
+        return nullptr;
+    }
+
+    HANDLE mh = CreateFileMappingA(fh, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mh) {
+        CloseHandle(fh);
+        return nullptr;
+    }
+
+    const void* addr = MapViewOfFile(mh, FILE_MAP_READ, 0, 0, 0);
+    if (!addr) {
+        CloseHandle(mh);
+        CloseHandle(fh);
+        return nullptr;
+    }
+
+    auto mf = std::make_shared<MmapFile>();
+    mf->data        = static_cast<const uint8_t*>(addr);
+    mf->size        = static_cast<size_t>(sz.QuadPart);
+    mf->file_handle = fh;
+    mf->map_handle  = mh;
+    return mf;
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return nullptr;
+    }
+
+    void* addr = mmap(nullptr, static_cast<size_t>(st.st_size),
+                      PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // マッピング確立後は fd 不要（マッピングは独立して生きる）
+    if (addr == MAP_FAILED) return nullptr;
+
+    auto mf = std::make_shared<MmapFile>();
+    mf->data = static_cast<const uint8_t*>(addr);
+    mf->size = static_cast<size_t>(st.st_size);
+    return mf;
+#endif
+}
+
+MmapFile::~MmapFile()
+{
+#if defined(_WIN32) || defined(_WIN64)
+    if (data)        UnmapViewOfFile(data);
+    if (map_handle)  CloseHandle(static_cast<HANDLE>(map_handle));
+    if (file_handle) CloseHandle(static_cast<HANDLE>(file_handle));
+#else
+    if (data) munmap(const_cast<uint8_t*>(data), size);
+#endif
+}
+
+static std::string f0_layer_path(const std::string& hash) {
+    return get_cache_dir() + "/" + hash + ".vsf";
+}
+
+static std::string spec_layer_path(const std::string& hash, int spec_bins) {
+    return get_cache_dir() + "/" + hash + "_b" + std::to_string(spec_bins) + ".vsc";
+}
+
+// 書き途中でクラッシュしても破損キャッシュが残らないよう
+// 一時ファイルに書いてからアトミックにリネームする共通処理
+static void atomic_write_finish(FILE* fp, bool ok,
+                                const std::string& tmp_path,
+                                const std::string& dst_path)
+{
+    fclose(fp);
+    if (ok) {
+        rename(tmp_path.c_str(), dst_path.c_str());  // アトミック置換
+    } else {
+        unlink(tmp_path.c_str());  // 書き込み失敗なら一時ファイルを削除
+    }
+}
+
+static void save_f0_layer(const std::string& path, const AnalysisCache& cache)
 {
-    // 書き途中でクラッシュしても破損キャッシュが残らないよう
-    // 一時ファイルに書いてからアトミックにリネームする
-    std::string tmp_path = cache_path + ".tmp";
+    std::string tmp_path = path + ".tmp";
+    FILE* fp = fopen(tmp_path.c_str(), "wb");
+    if (!fp) return;
+
+    bool ok = true;
+    VoseF0CacheHeader header;
+    header.magic  = 0x46534F56;  // 'VOSF'
+    header.length = cache.length;
+
+    ok &= (fwrite(&header,            sizeof(header), 1,            fp) == 1);
+    ok &= (fwrite(cache.f0_data(),    sizeof(double), cache.length, fp) == static_cast<size_t>(cache.length));
+    ok &= (fwrite(cache.time_data(),  sizeof(double), cache.length, fp) == static_cast<size_t>(cache.length));
+    atomic_write_finish(fp, ok, tmp_path, path);
+}
 
+static void save_spec_layer(const std::string& path, const AnalysisCache& cache)
+{
+    std::string tmp_path = path + ".tmp";
     FILE* fp = fopen(tmp_path.c_str(), "wb");
     if (!fp) return;
 
     bool ok = true;
     VoseCacheHeader header;
-    header.magic     = 0x45534F56;
+    header.magic     = 0x45534F56;  // 'VOSE'
+    header.version   = 2;           // v2: log float32 spec / float32 ap
     header.length    = cache.length;
     header.spec_bins = cache.spec_bins;
 
-    ok &= (fwrite(&header,             sizeof(header),  1,            fp) == 1);
-    ok &= (fwrite(cache.f0.data(),     sizeof(double),  cache.length, fp) == static_cast<size_t>(cache.length));
-    ok &= (fwrite(cache.time.data(),   sizeof(double),  cache.length, fp) == static_cast<size_t>(cache.length));
     const size_t sc = static_cast<size_t>(cache.length) * cache.spec_bins;
-    ok &= (fwrite(cache.flat_spec.data(), sizeof(double), sc, fp) == sc);
-    ok &= (fwrite(cache.flat_ap.data(),   sizeof(double), sc, fp) == sc);
-    fclose(fp);
+    ok &= (fwrite(&header,           sizeof(header), 1,  fp) == 1);
+    ok &= (fwrite(cache.spec_data(), sizeof(float),  sc, fp) == sc);
+    ok &= (fwrite(cache.ap_data(),   sizeof(float),  sc, fp) == sc);
+    atomic_write_finish(fp, ok, tmp_path, path);
+}
 
-    if (ok) {
-        std::error_code ec;
-        rename(tmp_path.c_str(), cache_path.c_str());  // アトミック置換
-        // 失敗時はtmpファイルを削除
-        // (rename失敗時のエラー処理は省略)
-    } else {
-        unlink(tmp_path.c_str());  // 書き込み失敗なら一時ファイルを削除
-    }
+static void save_cache_layers(const std::string& hash, const AnalysisCache& cache)
+{
+    save_f0_layer(f0_layer_path(hash), cache);
+    save_spec_layer(spec_layer_path(hash, cache.spec_bins), cache);
+}
+
+// 各 read の成否を検証するヘルパ
+static bool read_check(std::ifstream& ifs, void* dst, size_t bytes) {
+    return static_cast<bool>(
+        ifs.read(reinterpret_cast<char*>(dst), static_cast<std::streamsize>(bytes)));
+}
+
+static bool stream_at_eof(std::ifstream& ifs) {
+    // ストリームが正確に末尾に達しているか確認（余剰バイトがある = ファイル破損とみなす）
+    return ifs.peek() == std::ifstream::traits_type::eof();
 }
 
-static std::shared_ptr<AnalysisCache> load_cache(const std::string& path,
-                                                 int expected_spec_bins = 0)
+// F0層のみを読み込む。成功時は f0/time/length だけ埋まった
+// AnalysisCache を返す（spec層は呼び出し側が合成・追加する）。
+// mmap が使えればビューを張るだけでコピーしない。
+static std::shared_ptr<AnalysisCache> load_f0_layer(const std::string& path)
 {
+    // --- mmap 経路（ゼロコピー）---
+    if (auto mf = MmapFile::open(path)) {
+        if (mf->size < sizeof(VoseF0CacheHeader)) return nullptr;
+        const auto* header =
+            reinterpret_cast<const VoseF0CacheHeader*>(mf->data);
+        if (header->magic != 0x46534F56) return nullptr;
+        // サニティチェック: 長さが異常値ならキャッシュ破棄（OOM防止）
+        if (header->length <= 0 || header->length > 1'000'000) return nullptr;
+        // ファイルサイズが厳密に一致しない = 破損とみなす
+        const size_t need = sizeof(VoseF0CacheHeader)
+                          + sizeof(double) * 2 * static_cast<size_t>(header->length);
+        if (mf->size != need) return nullptr;
+
+        auto cache = std::make_shared<AnalysisCache>();
+        cache->length    = header->length;
+        cache->f0_view   = reinterpret_cast<const double*>(
+                               mf->data + sizeof(VoseF0CacheHeader));
+        cache->time_view = cache->f0_view + header->length;
+        cache->f0_map    = std::move(mf);  // マッピングの寿命をキャッシュに紐付け
+        return cache;
+    }
+
+    // --- フォールバック（mmap 非対応 FS など）: 従来の read 経路 ---
     struct stat st;
     if (stat(path.c_str(), &st) != 0) return nullptr;
 
     std::ifstream ifs(path, std::ios::binary);
     if (!ifs) return nullptr;
 
-    VoseCacheHeader header{};
-    if (!ifs.read(reinterpret_cast<char*>(&header), sizeof(header))) return nullptr;
-
-    // マジック検証
-    if (header.magic != 0x45534F56) return nullptr;
-
-    // サニティチェック: 長さ・spec_bins が異常値ならキャッシュ破棄（OOM防止）
+    VoseF0CacheHeader header{};
+    if (!read_check(ifs, &header, sizeof(header))) return nullptr;
+    if (header.magic != 0x46534F56) return nullptr;
     if (header.length <= 0 || header.length > 1'000'000) return nullptr;
-    if (header.spec_bins <= 0 || header.spec_bins > 65536) return nullptr;
-
-    // spec_bins 互換チェック:
-    // fft_size が変わると spec_bins が変わる。異なるサイズのキャッシュを
-    // 読み込むと配列の境界外アクセスが起きるため、不一致なら再解析させる。
-    if (expected_spec_bins > 0 && header.spec_bins != expected_spec_bins) {
-        return nullptr;
-    }
 
     auto cache = std::make_shared<AnalysisCache>();
-    cache->length    = header.length;
-    cache->spec_bins = header.spec_bins;
-    
-    // メモリ確保
+    cache->length = header.length;
     cache->f0  .resize(cache->length);
     cache->time.resize(cache->length);
-    const size_t sc = static_cast<size_t>(cache->length) * cache->spec_bins;
-    cache->flat_spec.resize(sc);
-    cache->flat_ap  .resize(sc);
 
-    // 各 read の成否を検証するラムダ
-    auto read_check = [&](void* dst, size_t bytes) -> bool {
-        return static_cast<bool>(
-            ifs.read(reinterpret_cast<char*>(dst), static_cast<std::streamsize>(bytes)));
+    if (!read_check(ifs, cache->f0.data(),   sizeof(cache->f0[0])   * cache->length)) return nullptr;
+    if (!read_check(ifs, cache->time.data(), sizeof(cache->time[0]) * cache->length)) return nullptr;
+    if (!stream_at_eof(ifs)) return nullptr;
+
+    return cache;
+}
+
+// スペクトル層を cache に追記読み込みする。
+// F0層と length が一致しない場合は破損とみなして失敗させる。
+// こちらも mmap ビューを優先し、読めなければ read にフォールバック。
+static bool load_spec_layer_into(const std::string& path, AnalysisCache& cache,
+                                 int expected_spec_bins)
+{
+    // ヘッダ共通の検証
+    auto header_ok = [&](const VoseCacheHeader& header) -> bool {
+        if (header.magic != 0x45534F56) return false;
+        // 版数不一致（旧 double 格納の v1 など）は再解析させる
+        if (header.version != 2) return false;
+        if (header.length != cache.length) return false;
+        if (header.spec_bins <= 0 || header.spec_bins > 65536) return false;
+        if (expected_spec_bins > 0 && header.spec_bins != expected_spec_bins) return false;
+        return true;
     };
 
-    // 【最適化】sizeof(double) をコンテナの要素型（sizeof(cache->...[0])）に書き換え、
-    // 将来的に float 等に型変更してもバグが出ないよう安全性を担保。
-    if (!read_check(cache->f0.data(),        sizeof(cache->f0[0]) * cache->length))  return nullptr;
-    if (!read_check(cache->time.data(),      sizeof(cache->time[0]) * cache->length)) return nullptr;
-    if (!read_check(cache->flat_spec.data(), sizeof(cache->flat_spec[0]) * sc))      return nullptr;
-    if (!read_check(cache->flat_ap.data(),   sizeof(cache->flat_ap[0]) * sc))        return nullptr;
+    // --- mmap 経路（ゼロコピー）---
+    if (auto mf = MmapFile::open(path)) {
+        if (mf->size < sizeof(VoseCacheHeader)) return false;
+        const auto* header =
+            reinterpret_cast<const VoseCacheHeader*>(mf->data);
+        if (!header_ok(*header)) return false;
+
+        const size_t sc   = static_cast<size_t>(header->length) * header->spec_bins;
+        const size_t need = sizeof(VoseCacheHeader) + sizeof(float) * 2 * sc;
+        if (mf->size != need) return false;
+
+        cache.spec_bins = header->spec_bins;
+        cache.spec_view = reinterpret_cast<const float*>(
+                              mf->data + sizeof(VoseCacheHeader));
+        cache.ap_view   = cache.spec_view + sc;
+        cache.spec_map  = std::move(mf);
+        return true;
+    }
 
-    // ストリームが正確に末尾に達しているか確認（余剰バイトがある = ファイル破損とみなす）
-    if (ifs.peek() != std::ifstream::traits_type::eof()) return nullptr;
+    // --- フォールバック: 従来の read 経路 ---
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) return false;
 
-    return cache;
+    std::ifstream ifs(path, std::ios::binary);
+    if (!ifs) return false;
+
+    VoseCacheHeader header{};
+    if (!read_check(ifs, &header, sizeof(header))) return false;
+    if (!header_ok(header)) return false;
+
+    cache.spec_bins = header.spec_bins;
+    const size_t sc = static_cast<size_t>(cache.length) * cache.spec_bins;
+    cache.flat_spec.resize(sc);
+    cache.flat_ap  .resize(sc);
+
+    if (!read_check(ifs, cache.flat_spec.data(), sizeof(cache.flat_spec[0]) * sc)) return false;
+    if (!read_check(ifs, cache.flat_ap.data(),   sizeof(cache.flat_ap[0])   * sc)) return false;
+    return stream_at_eof(ifs);
 }
 // ============================================================
 // build_analysis_cache
 // ============================================================
 
-static std::shared_ptr<const AnalysisCache>
-build_analysis_cache(const EmbeddedVoice& ev, int fft_size, int spec_bins)
+// GetFFTSizeForCheapTrick は option->f0_floor を無条件に参照するため、
+// nullptr を渡すのは不可。デフォルト設定の FFT サイズが欲しい箇所は
+// このヘルパー経由で取得する。
+static int default_fft_size(int fs)
 {
-    auto cache = std::make_shared<AnalysisCache>();
-    cache->spec_bins = spec_bins;
+    CheapTrickOption opt;
+    InitializeCheapTrickOption(fs, &opt);
+    return opt.fft_size;
+}
 
-    HarvestOption opt;
-    InitializeHarvestOption(&opt);
-    opt.frame_period = kFramePeriod;
-    opt.f0_floor     = 50.0;
-    opt.f0_ceil      = 800.0;
+// ============================================================
+// 解析品質ティア
+// ============================================================
+// 0 = プレビュー（Dio + StoneMask。Harvest の約1/10のコストで、
+//     スクラブ中のストリーミング再生の応答性を優先する）
+// 1 = 最終（Harvest。デフォルト）
+// プレビュー解析は別のキャッシュキー（"#dio" サフィックス）に
+// 格納されるため、後から品質を上げても最終品質のエントリが
+// 新規に作られるだけで、プレビューのF0が混入することはない。
+static std::atomic<int> g_analysis_quality{1};
+
+DLLEXPORT void set_analysis_quality(int quality)
+{
+    g_analysis_quality.store(quality != 0 ? 1 : 0, std::memory_order_relaxed);
+}
 
-    const int wav_len     = static_cast<int>(ev.waveform.size());
+// f0_layer: ディスクのF0層から復元した f0/time（nullptr なら F0 推定を実行）。
+// F0 推定が解析コストの支配項なので、fft_size 変更時の再解析は
+// このパラメータ経由で CheapTrick/D4C だけに短縮される。
+// dio_f0: true ならプレビュー用に Dio + StoneMask で F0 推定する。
+static std::shared_ptr<const AnalysisCache>
+build_analysis_cache(const EmbeddedVoice& ev, int fft_size, int spec_bins,
+                     std::shared_ptr<AnalysisCache> f0_layer = nullptr,
+                     bool dio_f0 = false)
+{
+    const int wav_len     = ev.length();
     const int harvest_len = GetSamplesForHarvest(ev.fs, wav_len, kFramePeriod);
-    cache->f0.resize(harvest_len);
-    cache->time.resize(harvest_len);
-    cache->length = harvest_len;
 
-    Harvest(ev.waveform.data(), wav_len, ev.fs, &opt,
-            cache->time.data(), cache->f0.data());
+    // int16 → double の遅延デコード。このスコープ限定のローカルなので
+    // 解析が終われば解放され、double 波形が常駐することはない。
+    const std::vector<double> wav = ev.decode_waveform();
 
-    // F0補完: 無声区間を前後の有声値で線形補間
-    {
-        std::vector<int> vi;
-        vi.reserve(harvest_len);
-        for (int i = 0; i < harvest_len; ++i)
-            if (cache->f0[i] > 0.0) vi.push_back(i);
-
-        if (!vi.empty()) {
-            for (int i = 0; i < vi.front(); ++i)
-                cache->f0[i] = cache->f0[vi.front()];
-            for (int i = vi.back()+1; i < harvest_len; ++i)
-                cache->f0[i] = cache->f0[vi.back()];
-            for (int v = 0; v+1 < static_cast<int>(vi.size()); ++v) {
-                const int ia = vi[v], ib = vi[v+1];
-                if (ib-ia <= 1) continue;
-                const double fa = cache->f0[ia], fb = cache->f0[ib];
-                for (int i = ia+1; i < ib; ++i)
-                    cache->f0[i] = fa + static_cast<double>(i-ia)/(ib-ia)*(fb-fa);
-            }
+    // 再利用するF0層の長さが現在の波形と食い違っていたら捨てる
+    if (f0_layer && f0_layer->length != harvest_len) f0_layer = nullptr;
+
+    std::shared_ptr<AnalysisCache> cache;
+    if (f0_layer) {
+        cache = std::move(f0_layer);
+    } else {
+        cache = std::make_shared<AnalysisCache>();
+
+        cache->f0.resize(harvest_len);
+        cache->time.resize(harvest_len);
+        cache->length = harvest_len;
+
+        if (dio_f0) {
+            // プレビューティア: Dio で粗く推定し StoneMask で精緻化する。
+            // GetSamplesForDIO と GetSamplesForHarvest は同一式なので
+            // フレーム数はそのまま一致する。
+            DioOption opt;
+            InitializeDioOption(&opt);
+            opt.frame_period = kFramePeriod;
+            opt.f0_floor     = 50.0;
+            opt.f0_ceil      = 800.0;
+
+            std::vector<double> raw_f0(harvest_len);
+            Dio(wav.data(), wav_len, ev.fs, &opt,
+                cache->time.data(), raw_f0.data());
+            StoneMask(wav.data(), wav_len, ev.fs,
+                      cache->time.data(), raw_f0.data(), harvest_len,
+                      cache->f0.data());
         } else {
-            std::fill(cache->f0.begin(), cache->f0.end(), 440.0);
+            HarvestOption opt;
+            InitializeHarvestOption(&opt);
+            opt.frame_period = kFramePeriod;
+            opt.f0_floor     = 50.0;
+            opt.f0_ceil      = 800.0;
+            // Harvest が解析コストの支配項。チャンネルフィルタと候補精緻化を
+            // ワーカープールと同数のスレッドで並列化する
+            opt.n_threads    = vose_worker_pool().worker_count();
+
+            Harvest(wav.data(), wav_len, ev.fs, &opt,
+                    cache->time.data(), cache->f0.data());
+        }
+
+        // F0補完: 無声区間を前後の有声値で線形補間
+        {
+            std::vector<int> vi;
+            vi.reserve(harvest_len);
+            for (int i = 0; i < harvest_len; ++i)
+                if (cache->f0[i] > 0.0) vi.push_back(i);
+
+            if (!vi.empty()) {
+                for (int i = 0; i < vi.front(); ++i)
+                    cache->f0[i] = cache->f0[vi.front()];
+                for (int i = vi.back()+1; i < harvest_len; ++i)
+                    cache->f0[i] = cache->f0[vi.back()];
+                for (int v = 0; v+1 < static_cast<int>(vi.size()); ++v) {
+                    const int ia = vi[v], ib = vi[v+1];
+                    if (ib-ia <= 1) continue;
+                    const double fa = cache->f0[ia], fb = cache->f0[ib];
+                    for (int i = ia+1; i < ib; ++i)
+                        cache->f0[i] = fa + static_cast<double>(i-ia)/(ib-ia)*(fb-fa);
+                }
+            } else {
+                std::fill(cache->f0.begin(), cache->f0.end(), 440.0);
+            }
         }
     }
 
+    cache->spec_bins = spec_bins;
     const size_t sc = static_cast<size_t>(harvest_len) * spec_bins;
-    cache->flat_spec.resize(sc);
-    cache->flat_ap  .resize(sc);
 
+    // CheapTrick/D4C は double で計算し、直後に v2 表現
+    // （log float32 / float32）へ変換して格納する。
+    // 作業用 double バッファは関数を抜けた時点で解放される。
+    std::vector<double> spec_work(sc), ap_work(sc);
     std::vector<double*> sp(harvest_len), ap(harvest_len);
     for (int i = 0; i < harvest_len; ++i) {
-        sp[i] = &cache->flat_spec[static_cast<size_t>(i)*spec_bins];
-        ap[i] = &cache->flat_ap  [static_cast<size_t>(i)*spec_bins];
+        sp[i] = &spec_work[static_cast<size_t>(i)*spec_bins];
+        ap[i] = &ap_work  [static_cast<size_t>(i)*spec_bins];
+    }
+    // フレーム並列化: CheapTrick/D4C のフレームループは完全独立なので
+    // ワーカープールと同じ本数のスレッドに分割する。解析が複数音素で
+    // 同時に走ると一時的にオーバーサブスクライブするが、コールドスタート
+    // 限定の短時間なのでOSスケジューラに任せる。
+    // 注: 従来この2つに nullptr オプションを渡していたが、upstream の
+    // CheapTrick/D4C は option を無条件に参照するため、正規のオプション
+    // 構造体を渡すよう修正した。
+    const int analysis_threads = vose_worker_pool().worker_count();
+
+    CheapTrickOption ct_opt;
+    InitializeCheapTrickOption(ev.fs, &ct_opt);
+    ct_opt.fft_size  = fft_size;
+    ct_opt.n_threads = analysis_threads;
+
+    D4COption d4c_opt;
+    InitializeD4COption(&d4c_opt);
+    d4c_opt.n_threads = analysis_threads;
+
+    // f0/time は mmap ビュー経由の場合があるためアクセサで参照する
+    CheapTrick(wav.data(), wav_len, ev.fs,
+               cache->time_data(), cache->f0_data(), harvest_len, &ct_opt, sp.data());
+    D4C(wav.data(), wav_len, ev.fs,
+        cache->time_data(), cache->f0_data(), harvest_len, fft_size, &d4c_opt, ap.data());
+
+    cache->flat_spec.resize(sc);
+    cache->flat_ap  .resize(sc);
+    for (size_t i = 0; i < sc; ++i) {
+        cache->flat_spec[i] = encode_spec(spec_work[i]);
+        cache->flat_ap  [i] = static_cast<float>(clamp(ap_work[i], 0.0, 1.0));
     }
-    CheapTrick(ev.waveform.data(), wav_len, ev.fs,
-               cache->time.data(), cache->f0.data(), harvest_len, nullptr, sp.data());
-    D4C(ev.waveform.data(), wav_len, ev.fs,
-        cache->time.data(), cache->f0.data(), harvest_len, fft_size, nullptr, ap.data());
 
     return cache;
 }
@@ -558,22 +1172,60 @@ build_analysis_cache(const EmbeddedVoice& ev, int fft_size, int spec_bins)
 // ============================================================
 
 std::shared_ptr<const AnalysisCache>
-get_or_analyze(std::shared_ptr<const EmbeddedVoice> ev_sp, int fft_size, int spec_bins)
+get_or_analyze(std::shared_ptr<const EmbeddedVoice> ev_sp, int fft_size, int spec_bins,
+               int quality_override = -1)
 {
     if (!ev_sp) return nullptr;
-    const std::string& key = ev_sp->path;
+
+    // プレビューティアは別キーに格納する（メモリ・ディスクとも）。
+    // 後から Harvest 品質で解析し直しても別エントリになるだけで、
+    // 旧プレビューのF0が最終レンダに混ざることはない。
+    // quality_override >= 0 なら呼び出し単位でティアを強制する
+    // （ストリーミングの品質ガバナーが縮退時に 0 = Dio を渡す）。
+    const bool  preview = (quality_override >= 0)
+        ? (quality_override == 0)
+        : (g_analysis_quality.load(std::memory_order_relaxed) == 0);
+    std::string key     = ev_sp->path;
+    if (preview) key += "#dio";
 
     // 1. メモリキャッシュ（LRU）のファーストチェック
+    // ヒット/ミスは初回ルックアップの結果で計上する
+    // （二重チェックでの救済ヒットはミス側に数えたままにする）
     {
         VoseUniqueLock rlock(g_analysis_cache_mutex);
         auto cached = g_analysis_cache.get(key);
-        if (cached) return cached;
+        if (cached) {
+            g_engine_stats.cache_hits.fetch_add(1, std::memory_order_relaxed);
+            return cached;
+        }
     }
+    g_engine_stats.cache_misses.fetch_add(1, std::memory_order_relaxed);
 
     // 2. ロックを外した状態でディスクキャッシュのパス生成と読み込み（I/Oボトルネックの分離）
-    const std::string h_str      = generate_cache_hash(key);
-    const std::string cache_file = get_cache_dir() + "/" + h_str + ".vsc";
-    auto disk_cache = load_cache(cache_file, spec_bins);
+    //    F0層を先に読み、あればスペクトル層を追記読み込みする。
+    //    スペクトル層だけが無い/不一致（fft_size 変更後など）でも
+    //    F0層は生かして Harvest をスキップできるよう保持しておく。
+    // ディスク側はハッシュに "_dio" サフィックスを付けて区別する
+    // （ハッシュ自体は実ファイルパスから生成し mtime/サイズ失効を保つ）
+    std::string h_str = generate_cache_hash(ev_sp->path);
+    if (preview) h_str += "_dio";
+    const uint64_t t_load = stats_now_ns();
+    std::shared_ptr<AnalysisCache> f0_layer   = load_f0_layer(f0_layer_path(h_str));
+    std::shared_ptr<AnalysisCache> disk_cache = nullptr;
+    if (f0_layer &&
+        load_spec_layer_into(spec_layer_path(h_str, spec_bins), *f0_layer, spec_bins)) {
+        disk_cache = std::move(f0_layer);
+    }
+    if (f0_layer || disk_cache) {
+        // 読み込めた層の実データ量を計上（f0/time は double、spec/ap は float32）
+        const AnalysisCache& c = disk_cache ? *disk_cache : *f0_layer;
+        uint64_t bytes = static_cast<uint64_t>(c.length) * 2 * sizeof(double);
+        if (disk_cache)
+            bytes += static_cast<uint64_t>(c.length) * c.spec_bins * 2 * sizeof(float);
+        g_engine_stats.disk_load_bytes.fetch_add(bytes, std::memory_order_relaxed);
+        g_engine_stats.disk_load_ns.fetch_add(stats_now_ns() - t_load,
+                                              std::memory_order_relaxed);
+    }
 
     // 3. 書き込みロックを取得して状態を確定させる
     VoseUniqueLock wlock(g_analysis_cache_mutex);
@@ -593,9 +1245,11 @@ get_or_analyze(std::shared_ptr<const EmbeddedVoice> ev_sp, int fft_size, int spe
     }
 
     // 4. キャッシュがどこにもない場合のみ、WORLDで新規解析を実行
+    // F0層だけディスクにあれば Harvest をスキップし CheapTrick/D4C のみ再計算。
     // ロックを持ったまま解析すると全スレッドが止まるため、一時的にロックを解除（重要）
     wlock.unlock();
-    auto cache = build_analysis_cache(*ev_sp, fft_size, spec_bins);
+    auto cache = build_analysis_cache(*ev_sp, fft_size, spec_bins,
+                                      std::move(f0_layer), preview);
     wlock.lock(); // メモリキャッシュへ書き込むために再ロック
 
     // 解析中に別のスレッドが同じファイルを解析し終えていないか、最終防衛ラインのチェック
@@ -609,7 +1263,16 @@ get_or_analyze(std::shared_ptr<const EmbeddedVoice> ev_sp, int fft_size, int spe
     
     // ディスクへの書き込みは重いため、ロックを完全に解除してから非同期（または安全なスコープ）で行う
     wlock.unlock();
-    save_cache(cache_file, *cache);
+    {
+        const uint64_t t_save = stats_now_ns();
+        save_cache_layers(h_str, *cache);
+        g_engine_stats.disk_save_bytes.fetch_add(
+            static_cast<uint64_t>(cache->length) * 2 * sizeof(double) +
+            static_cast<uint64_t>(cache->length) * cache->spec_bins * 2 * sizeof(float),
+            std::memory_order_relaxed);
+        g_engine_stats.disk_save_ns.fetch_add(stats_now_ns() - t_save,
+                                              std::memory_order_relaxed);
+    }
 
     return cache;
 }
@@ -619,7 +1282,7 @@ get_or_analyze(std::shared_ptr<const EmbeddedVoice> ev_sp, int fft_size, int spe
 // ============================================================
 
 double get_source_ms(const EmbeddedVoice& ev) {
-    return static_cast<double>(ev.waveform.size()) / ev.fs * 1000.0;
+    return static_cast<double>(ev.length()) / ev.fs * 1000.0;
 }
 
 double map_time(double t_out_ms, const OtoEntry& oto,
@@ -640,26 +1303,28 @@ double map_time(double t_out_ms, const OtoEntry& oto,
 // copy_cache_to_scratch
 // ============================================================
 
-static void copy_cache_to_scratch_cur(const AnalysisCache& c)
+// v2 キャッシュ（log float32 / float32）の1行を double 行へ展開する。
+// ここが float32 圧縮表現と double DSP パイプラインの境界になる。
+static void decode_cache_row(const AnalysisCache& c, int src_frame,
+                             double* spec_dst, double* ap_dst)
 {
-    tl_scratch.ensure_spec(c.length, c.spec_bins);
-    const size_t total = static_cast<size_t>(c.length) * c.spec_bins;
-    std::copy(c.flat_spec.begin(), c.flat_spec.begin()+total, tl_scratch.flat_spec.begin());
-    std::copy(c.flat_ap  .begin(), c.flat_ap  .begin()+total, tl_scratch.flat_ap  .begin());
-    tl_scratch.ensure_f0(c.length);
-    std::copy(c.f0  .begin(), c.f0  .begin()+c.length, tl_scratch.f0       .begin());
-    std::copy(c.time.begin(), c.time.begin()+c.length, tl_scratch.time_axis.begin());
+    const float* sp = c.spec_data() + static_cast<size_t>(src_frame) * c.spec_bins;
+    const float* ap = c.ap_data()   + static_cast<size_t>(src_frame) * c.spec_bins;
+    for (int k = 0; k < c.spec_bins; ++k) spec_dst[k] = decode_spec(sp[k]);
+    for (int k = 0; k < c.spec_bins; ++k) ap_dst[k]   = static_cast<double>(ap[k]);
 }
 
-static void copy_cache_to_scratch_prev(const AnalysisCache& c)
+// prev 音素はブレンドで参照される末尾 tail フレームだけを展開する。
+// 以前は前音素のスペクトログラム全体を複製していたが、
+// blend_transition_spectra が読むのは末尾 kTransitionFrames 行のみ。
+// 展開先は prev スクラッチの行 [0, tail)。呼び出し側は prev_len として
+// tail を渡せば blend 側のインデックス計算がそのまま一致する。
+static void copy_cache_tail_to_scratch_prev(const AnalysisCache& c, int tail)
 {
-    tl_scratch.ensure_spec(c.length, c.spec_bins);
-    const size_t total = static_cast<size_t>(c.length) * c.spec_bins;
-    std::copy(c.flat_spec.begin(), c.flat_spec.begin()+total, tl_scratch.flat_spec_prev.begin());
-    std::copy(c.flat_ap  .begin(), c.flat_ap  .begin()+total, tl_scratch.flat_ap_prev  .begin());
-    tl_scratch.ensure_f0_prev(c.length);
-    std::copy(c.f0  .begin(), c.f0  .begin()+c.length, tl_scratch.f0_prev       .begin());
-    std::copy(c.time.begin(), c.time.begin()+c.length, tl_scratch.time_axis_prev.begin());
+    const int first = c.length - tail;
+    for (int i = 0; i < tail; ++i)
+        decode_cache_row(c, first + i,
+                         tl_scratch.spec_ptrs_prev[i], tl_scratch.ap_ptrs_prev[i]);
 }
 
 // ============================================================
@@ -690,7 +1355,7 @@ inline double resample_curve(const double* curve, int src_len,
 //   子音頭がクロスフェードに食われる問題を解消する。
 // ============================================================
 static void apply_crossfade(std::vector<double>& dst, int64_t dst_size,
-                             const std::vector<double>& src, int64_t src_size,
+                             const double* src, int64_t src_size,
                              int64_t offset, int xfade_len,
                              int64_t overlap_samples = 0)
 {
@@ -717,6 +1382,107 @@ static void apply_crossfade(std::vector<double>& dst, int64_t dst_size,
         dst[s] = src[src_start + (s - offset)];
 }
 
+// ============================================================
+// AVX2 SIMD カーネル（log / exp / tanh の4並列近似）
+// ============================================================
+// CMakeLists.txt は x86_64 で -mavx2 -mfma (/arch:AVX2) を強制している
+// ため、選択はコンパイル時の __AVX2__ で足りる（ARM等はスカラー経路）。
+// log/exp は Cephes 系の有理多項式近似。倍精度での相対誤差は
+// exp ~3e-16 / log ~1e-14（x≈1 近傍は絶対誤差 ~1e-16）で、
+// スペクトル包絡のdB操作には十分すぎる精度。
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define VOSE_SIMD_AVX2 1
+
+namespace vose_simd {
+
+static inline __m256d exp_pd(__m256d x)
+{
+    // 引数クランプ（オーバー/アンダーフロー防止）
+    x = _mm256_min_pd(_mm256_max_pd(x, _mm256_set1_pd(-709.0)),
+                      _mm256_set1_pd(709.0));
+
+    // x = n*ln2 + r へ分解（ln2 は2段分割で桁落ちを防ぐ）
+    const __m256d log2e = _mm256_set1_pd(1.4426950408889634073599);
+    __m256d n = _mm256_round_pd(_mm256_mul_pd(x, log2e),
+        _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256d r = _mm256_fnmadd_pd(n, _mm256_set1_pd(6.93145751953125e-1), x);
+    r = _mm256_fnmadd_pd(n, _mm256_set1_pd(1.42860682030941723212e-6), r);
+
+    // e^r の有理近似 (Cephes exp.c)
+    __m256d r2 = _mm256_mul_pd(r, r);
+    __m256d px = _mm256_set1_pd(1.26177193074810590878e-4);
+    px = _mm256_fmadd_pd(px, r2, _mm256_set1_pd(3.02994407707441961300e-2));
+    px = _mm256_fmadd_pd(px, r2, _mm256_set1_pd(9.99999999999999999910e-1));
+    px = _mm256_mul_pd(px, r);
+    __m256d qx = _mm256_set1_pd(3.00198505138664455042e-6);
+    qx = _mm256_fmadd_pd(qx, r2, _mm256_set1_pd(2.52448340349684104192e-3));
+    qx = _mm256_fmadd_pd(qx, r2, _mm256_set1_pd(2.27265548208155028766e-1));
+    qx = _mm256_fmadd_pd(qx, r2, _mm256_set1_pd(2.0));
+    __m256d e = _mm256_div_pd(px, _mm256_sub_pd(qx, px));
+    __m256d y = _mm256_fmadd_pd(e, _mm256_set1_pd(2.0), _mm256_set1_pd(1.0));
+
+    // y *= 2^n（指数部へ直接加算）
+    __m128i ni = _mm256_cvtpd_epi32(n);
+    __m256i nl = _mm256_cvtepi32_epi64(ni);
+    nl = _mm256_slli_epi64(_mm256_add_epi64(nl, _mm256_set1_epi64x(1023)), 52);
+    return _mm256_mul_pd(y, _mm256_castsi256_pd(nl));
+}
+
+static inline __m256d log_pd(__m256d x)
+{
+    // 前提: x は正の正規化数（呼び出し側が kFloor でクランプ済み）
+    const __m256i mant_mask = _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL);
+    const __m256i half_bits = _mm256_set1_epi64x(0x3FE0000000000000LL);
+    __m256i xi = _mm256_castpd_si256(x);
+    __m256i ei = _mm256_sub_epi64(_mm256_srli_epi64(xi, 52),
+                                  _mm256_set1_epi64x(1022));
+    __m256d m = _mm256_castsi256_pd(
+        _mm256_or_si256(_mm256_and_si256(xi, mant_mask), half_bits));
+    // 指数（小さい整数）を epi64 → pd へ: 下位dwordを詰めて変換
+    const __m256i pack_idx = _mm256_setr_epi32(0, 2, 4, 6, 0, 0, 0, 0);
+    __m128i e32 = _mm256_castsi256_si128(
+        _mm256_permutevar8x32_epi32(ei, pack_idx));
+    __m256d e = _mm256_cvtepi32_pd(e32);
+
+    // m ∈ [0.5, 1) → m < 1/√2 なら 1オクターブ寄せる (Cephes log.c)
+    const __m256d sqrthf = _mm256_set1_pd(0.70710678118654752440);
+    __m256d mask = _mm256_cmp_pd(m, sqrthf, _CMP_LT_OQ);
+    e = _mm256_sub_pd(e, _mm256_and_pd(mask, _mm256_set1_pd(1.0)));
+    m = _mm256_sub_pd(_mm256_add_pd(m, _mm256_and_pd(mask, m)),
+                      _mm256_set1_pd(1.0));
+
+    __m256d z = _mm256_mul_pd(m, m);
+    __m256d p = _mm256_set1_pd(1.01875663804580931796e-4);
+    p = _mm256_fmadd_pd(p, m, _mm256_set1_pd(4.97494994976747001425e-1));
+    p = _mm256_fmadd_pd(p, m, _mm256_set1_pd(4.70579119878881725854e0));
+    p = _mm256_fmadd_pd(p, m, _mm256_set1_pd(1.44989225341610930846e1));
+    p = _mm256_fmadd_pd(p, m, _mm256_set1_pd(1.79368678507819816313e1));
+    p = _mm256_fmadd_pd(p, m, _mm256_set1_pd(7.70838733755885391666e0));
+    __m256d q = _mm256_add_pd(m, _mm256_set1_pd(1.12873587189167450590e1));
+    q = _mm256_fmadd_pd(q, m, _mm256_set1_pd(4.52279145837532221105e1));
+    q = _mm256_fmadd_pd(q, m, _mm256_set1_pd(8.29875266912776603211e1));
+    q = _mm256_fmadd_pd(q, m, _mm256_set1_pd(7.11544750618563894466e1));
+    q = _mm256_fmadd_pd(q, m, _mm256_set1_pd(2.31251620663687642340e1));
+
+    __m256d y = _mm256_mul_pd(_mm256_mul_pd(m, z), _mm256_div_pd(p, q));
+    y = _mm256_fnmadd_pd(e, _mm256_set1_pd(2.121944400546905827679e-4), y);
+    y = _mm256_fnmadd_pd(_mm256_set1_pd(0.5), z, y);
+    return _mm256_add_pd(_mm256_add_pd(m, y),
+                         _mm256_mul_pd(e, _mm256_set1_pd(0.693359375)));
+}
+
+static inline __m256d tanh_pd(__m256d x)
+{
+    // tanh(x) = (e^2x - 1) / (e^2x + 1)
+    const __m256d one = _mm256_set1_pd(1.0);
+    __m256d t = exp_pd(_mm256_add_pd(x, x));
+    return _mm256_div_pd(_mm256_sub_pd(t, one), _mm256_add_pd(t, one));
+}
+
+}  // namespace vose_simd
+#endif  // __AVX2__ && __FMA__
+
 // ============================================================
 // apply_gender_shift  （フォルマント追従付き高音域補正）
 //
@@ -746,10 +1512,49 @@ void apply_gender_shift(double* sr, int spec_bins, double gender,
     if (std::abs(shift_ratio - 1.0) < 1e-4) return;
 
     constexpr double kFloor = 1e-12;
-    for (int k = 0; k < spec_bins; ++k)
+    int k = 0;
+
+#ifdef VOSE_SIMD_AVX2
+    // log パス（4並列）
+    {
+        const __m256d vfloor = _mm256_set1_pd(kFloor);
+        for (; k + 4 <= spec_bins; k += 4) {
+            __m256d v = _mm256_max_pd(_mm256_loadu_pd(sr + k), vfloor);
+            _mm256_storeu_pd(tmp + k, vose_simd::log_pd(v));
+        }
+    }
+#endif
+    for (; k < spec_bins; ++k)
         tmp[k] = std::log(std::max(sr[k], kFloor));
 
-    for (int k = 0; k < spec_bins; ++k) {
+    k = 0;
+#ifdef VOSE_SIMD_AVX2
+    // 補間 + exp パス（4並列）
+    // k0+1 が範囲内に収まる区間だけベクトル化し、端はスカラーで処理
+    {
+        int vec_limit = std::min(spec_bins,
+            static_cast<int>(std::floor((spec_bins - 1) * shift_ratio)));
+        while (vec_limit > 0 &&
+               static_cast<int>((vec_limit - 1) / shift_ratio) >= spec_bins - 1)
+            --vec_limit;
+
+        const __m256d inv_ratio = _mm256_set1_pd(1.0 / shift_ratio);
+        for (; k + 4 <= vec_limit; k += 4) {
+            const __m256d kd = _mm256_setr_pd(
+                static_cast<double>(k),     static_cast<double>(k + 1),
+                static_cast<double>(k + 2), static_cast<double>(k + 3));
+            __m256d src  = _mm256_mul_pd(kd, inv_ratio);
+            __m256d k0d  = _mm256_floor_pd(src);
+            __m256d frac = _mm256_sub_pd(src, k0d);
+            __m128i k0i  = _mm256_cvttpd_epi32(k0d);
+            __m256d t0 = _mm256_i32gather_pd(tmp,     k0i, 8);
+            __m256d t1 = _mm256_i32gather_pd(tmp + 1, k0i, 8);
+            __m256d v  = _mm256_fmadd_pd(frac, _mm256_sub_pd(t1, t0), t0);
+            _mm256_storeu_pd(sr + k, vose_simd::exp_pd(v));
+        }
+    }
+#endif
+    for (; k < spec_bins; ++k) {
         const double src_k = static_cast<double>(k) / shift_ratio;
         const int    k0    = static_cast<int>(src_k);
         if (k0 >= spec_bins - 1) {
@@ -765,25 +1570,95 @@ void apply_gender_shift(double* sr, int spec_bins, double gender,
 // apply_tension_breath
 // ============================================================
 
+// 周波数重み（tension のシグモイド / breath の fw^0.7）は k と spec_bins
+// だけで決まるため、フレームごとに再計算せず spec_bins 単位で使い回す。
+// spec_bins はプロセス内で実質定数なので再計算は初回のみ。
+namespace {
+struct TensionWeightTable {
+    int bins = 0;
+    std::vector<double> sigmoid;   // 1/(1+exp(-8(fw-0.35)))
+    std::vector<double> breath_w;  // fw^0.7
+
+    void ensure(int spec_bins) {
+        if (bins == spec_bins) return;
+        bins = spec_bins;
+        sigmoid .resize(spec_bins);
+        breath_w.resize(spec_bins);
+        const double inv = 1.0 / (spec_bins - 1);
+        for (int k = 0; k < spec_bins; ++k) {
+            const double fw = static_cast<double>(k) * inv;
+            sigmoid[k]  = 1.0 / (1.0 + std::exp(-8.0 * (fw - 0.35)));
+            breath_w[k] = std::pow(fw, 0.7);
+        }
+    }
+};
+thread_local TensionWeightTable tl_tension_tbl;
+}  // namespace
+
 void apply_tension_breath(double* sr, double* ar, int spec_bins,
                                   double tension, double breath)
 {
     if (!sr || !ar || spec_bins <= 1) return;
-    const double inv = 1.0 / (spec_bins-1);
-    for (int k = 0; k < spec_bins; ++k) {
-        const double fw = static_cast<double>(k) * inv;
-        if (std::abs(tension-0.5) > 1e-4) {
-            const double weight     = 1.0/(1.0+std::exp(-8.0*(fw-0.35)));
-            const double gain_db    = (tension-0.5)*12.0*weight;
-            const double clipped_db = 6.0*std::tanh(gain_db/6.0);
-            sr[k] *= std::pow(10.0, clipped_db/20.0);
+
+    const bool do_tension = std::abs(tension - 0.5) > 1e-4;
+    const bool do_breath  = std::abs(breath  - 0.5) > 1e-4;
+    if (!do_tension && !do_breath) return;
+
+    tl_tension_tbl.ensure(spec_bins);
+    const double* sigmoid  = tl_tension_tbl.sigmoid .data();
+    const double* breath_w = tl_tension_tbl.breath_w.data();
+
+    const double tens_amt   = (tension - 0.5) * 12.0;
+    const double breath_amt = breath - 0.5;
+    // 10^(db/20) = exp(db * ln10/20)
+    constexpr double kLn10Div20 = 0.11512925464970228420;
+
+    int k = 0;
+#ifdef VOSE_SIMD_AVX2
+    {
+        const __m256d zero  = _mm256_setzero_pd();
+        const __m256d one   = _mm256_set1_pd(1.0);
+        const __m256d six   = _mm256_set1_pd(6.0);
+        const __m256d inv6  = _mm256_set1_pd(1.0 / 6.0);
+        const __m256d db2ln = _mm256_set1_pd(kLn10Div20);
+        const __m256d vtens = _mm256_set1_pd(tens_amt);
+        const __m256d vbrth = _mm256_set1_pd(breath_amt);
+        for (; k + 4 <= spec_bins; k += 4) {
+            if (do_tension) {
+                __m256d gain_db = _mm256_mul_pd(vtens,
+                    _mm256_loadu_pd(sigmoid + k));
+                __m256d clipped = _mm256_mul_pd(six,
+                    vose_simd::tanh_pd(_mm256_mul_pd(gain_db, inv6)));
+                __m256d factor  = vose_simd::exp_pd(
+                    _mm256_mul_pd(clipped, db2ln));
+                _mm256_storeu_pd(sr + k,
+                    _mm256_mul_pd(_mm256_loadu_pd(sr + k), factor));
+            }
+            if (do_breath) {
+                __m256d a      = _mm256_loadu_pd(ar + k);
+                __m256d amount = _mm256_mul_pd(vbrth,
+                    _mm256_loadu_pd(breath_w + k));
+                // amount >= 0 なら (1-ar)、負なら ar に比例して寄せる
+                __m256d ge  = _mm256_cmp_pd(amount, zero, _CMP_GE_OQ);
+                __m256d sel = _mm256_blendv_pd(a, _mm256_sub_pd(one, a), ge);
+                a = _mm256_fmadd_pd(amount, sel, a);
+                a = _mm256_min_pd(_mm256_max_pd(a, zero), one);
+                _mm256_storeu_pd(ar + k, a);
+            }
+        }
+    }
+#endif
+    for (; k < spec_bins; ++k) {
+        if (do_tension) {
+            const double gain_db    = tens_amt * sigmoid[k];
+            const double clipped_db = 6.0 * std::tanh(gain_db / 6.0);
+            sr[k] *= std::exp(clipped_db * kLn10Div20);
         }
-        if (std::abs(breath-0.5) > 1e-4) {
-            const double bw     = std::pow(fw, 0.7);
-            const double amount = (breath-0.5)*bw;
+        if (do_breath) {
+            const double amount = breath_amt * breath_w[k];
             ar[k] = amount >= 0.0
-                ? ar[k] + amount*(1.0-ar[k])
-                : ar[k] + amount*ar[k];
+                ? ar[k] + amount * (1.0 - ar[k])
+                : ar[k] + amount * ar[k];
             ar[k] = clamp(ar[k], 0.0, 1.0);
         }
     }
@@ -824,13 +1699,13 @@ void blend_transition_spectra(
 //
 // ノート後半50%からビブラートを自然に立ち上げる。
 // global_time_offset_sec: 曲先頭からの絶対時間 → ノートをまたいで位相連続
-// depth_curve/rate_curve: ノートごとの制御カーブ（nullptr = デフォルト）
+// depth_curve/rate_curve: prepare_curves でフレーム長（f0_length）に
+//   展開済みの制御カーブ（nullptr = デフォルト）
 // ============================================================
 void apply_vibrato(double* f0, int f0_length, double frame_period_ms,
                    double global_time_offset_sec,
                    const double* depth_curve,  // nullptr = 全フレーム 1.0
-                   const double* rate_curve,   // nullptr = 全フレーム 6.0Hz
-                   int curve_length)
+                   const double* rate_curve)   // nullptr = 全フレーム 6.0Hz
 {
     if (!f0 || f0_length <= 0) return;
 
@@ -847,13 +1722,9 @@ void apply_vibrato(double* f0, int f0_length, double frame_period_ms,
             static_cast<double>(j - vib_start) / std::max(vib_len - 1, 1);
         const double fade_in = std::min(fade_progress * 4.0, 1.0);
 
-        // カーブをリサンプリング（curve_length != f0_length でも対応）
-        const double depth = depth_curve
-            ? resample_curve(depth_curve, curve_length, j, f0_length)
-            : 1.0;
+        const double depth = depth_curve ? depth_curve[j] : 1.0;
         const double rate  = rate_curve
-            ? std::max(1.0, resample_curve(rate_curve, curve_length, j, f0_length))
-            : kVibFreqDef;
+            ? std::max(1.0, rate_curve[j]) : kVibFreqDef;
 
         const double t_global = global_time_offset_sec
                                 + static_cast<double>(j) * frame_sec;
@@ -902,21 +1773,97 @@ void smooth_f0_gaussian(double* f0, int f0_length)
 // VOSE_Synthesis
 // ============================================================
 
+// 帯気ノイズ変調用のプリコンピュート済みノイズリング。
+// 以前はスペクトログラムのセル単位で mt19937 を回していたが、
+// RNG呼び出しは直列・分岐ありで合成ホットパスの数%を占めていた。
+// 一様乱数はスレッドごとに一度だけまとめて生成し、変調ループは
+// 連続読みの add/clamp だけにする（統計的には同一。リングが一周して
+// 再利用されても無相関な帯気ゆらぎとしては知覚不能）。
+namespace {
+struct NoiseRing {
+    static constexpr int kSize = 16384;
+    std::vector<double> samples;
+    int pos = 0;
+
+    void ensure() {
+        if (!samples.empty()) return;
+        samples.resize(kSize);
+        std::mt19937 rng(
+            std::random_device{}() ^
+            static_cast<uint32_t>(std::hash<std::thread::id>{}(
+                std::this_thread::get_id())));
+        std::uniform_real_distribution<double> dist(-0.02, 0.02);
+        for (int i = 0; i < kSize; ++i) samples[i] = dist(rng);
+    }
+
+    // count 個の連続サンプルの先頭ポインタを返す（末尾に足りなければ巻き戻す）
+    const double* take(int count) {
+        if (pos + count > kSize) pos = 0;
+        const double* p = samples.data() + pos;
+        pos += count;
+        return p;
+    }
+};
+thread_local NoiseRing tl_noise_ring;
+
+// 合成FFTコンテキスト（スレッドごとに常駐）。
+// Synthesis() は呼び出しごとにプラン（Ooura の ip/w テーブル含む）と
+// 作業配列を確保・破棄していたが、1レンダー内は fft_size が一定なので
+// スレッドローカルに使い回す。fft_size が変わった場合は
+// SynthesisWithContext 側が透過的に再構築する。
+struct SynthesisContextHolder {
+    SynthesisContext ctx;
+    bool initialized = false;
+
+    SynthesisContext* get(int fft_size) {
+        if (!initialized) {
+            InitializeSynthesisContext(fft_size, &ctx);
+            initialized = true;
+        }
+        return &ctx;
+    }
+
+    ~SynthesisContextHolder() {
+        if (initialized) DestroySynthesisContext(&ctx);
+    }
+};
+thread_local SynthesisContextHolder tl_synth_ctx;
+}  // namespace
+
 static void VOSE_Synthesis(
     const double* f0, int f0_length,
     double** spectrogram, double** aperiodicity,
     int fft_size, double frame_period, int fs,
-    int y_length, double* y)
+    int y_length, double* y, bool flat_ap = false)
 {
+    // 品質ガバナーの縮退モード: 帯気変調（ビブラート連動 + ノイズリング）
+    // を省略し、解析済み ap をそのまま渡す。mod_ap への行コピー自体が
+    // 消えるので、変調ループとメモリトラフィックがまるごと浮く。
+    if (flat_ap) {
+        SynthesisWithContext(tl_synth_ctx.get(fft_size),
+                             f0, f0_length, spectrogram, aperiodicity,
+                             fft_size, frame_period, fs, y_length, y);
+
+        double prev_x = 0.0, prev_y_hp = 0.0;
+        for (int i = 0; i < y_length; ++i) {
+            double hp = y[i] - prev_x + 0.85*prev_y_hp;
+            prev_x = y[i];
+            prev_y_hp = hp;
+            y[i] += hp*0.05;
+        }
+        return;
+    }
+
     const int spec_bins = fft_size / 2 + 1;
-    tl_scratch.ensure_spec(f0_length, spec_bins);
+    tl_scratch.ensure_mod_ap(f0_length, spec_bins);
     double** mod_ap = tl_scratch.mod_ap_ptrs.data();
 
-    static thread_local std::mt19937 rng(
-        std::random_device{}() ^
-        static_cast<uint32_t>(std::hash<std::thread::id>{}(
-            std::this_thread::get_id())));
-    std::uniform_real_distribution<double> dist(-0.02, 0.02);
+    tl_noise_ring.ensure();
+
+    // 変調対象は freq = k*fs/fft_size > 2000Hz のビンのみ
+    int k_start = static_cast<int>(2000.0 * fft_size / fs) + 1;
+    if (k_start > spec_bins) k_start = spec_bins;
+    const int mod_bins = spec_bins - k_start;
 
     for (int i = 0; i < f0_length; ++i) {
         double* ap_dst = mod_ap[i];
@@ -925,16 +1872,19 @@ static void VOSE_Synthesis(
         if (i > 0 && i < f0_length-1)
             delta_f0 = std::abs(f0[i+1]-f0[i-1])*0.5;
         const double vibrato_breath = std::min(0.15, delta_f0*0.003);
-        for (int k = 0; k < spec_bins; ++k) {
-            double current_ap = ap_src[k];
-            const double freq = static_cast<double>(k)*fs/fft_size;
-            if (freq > 2000.0) current_ap += vibrato_breath + dist(rng);
-            ap_dst[k] = clamp(current_ap, 0.0, 1.0);
-        }
+
+        for (int k = 0; k < k_start; ++k)
+            ap_dst[k] = clamp(ap_src[k], 0.0, 1.0);
+
+        const double* nz = tl_noise_ring.take(mod_bins);
+        for (int k = k_start; k < spec_bins; ++k)
+            ap_dst[k] = clamp(
+                ap_src[k] + vibrato_breath + nz[k - k_start], 0.0, 1.0);
     }
 
-    Synthesis(f0, f0_length, spectrogram, mod_ap,
-              fft_size, frame_period, fs, y_length, y);
+    SynthesisWithContext(tl_synth_ctx.get(fft_size),
+                         f0, f0_length, spectrogram, mod_ap,
+                         fft_size, frame_period, fs, y_length, y);
 
     double prev_x = 0.0, prev_y_hp = 0.0;
     for (int i = 0; i < y_length; ++i) {
@@ -979,7 +1929,7 @@ static const double kPostEQ[6][5] = {
     {  1.0679214447,  0.4618551642,  0.1643779455,  0.5229532628,  0.1712012916 }, // 14kHz +1.5dB high shelf
 };
 
-static void apply_post_eq(double* y, int y_length)
+void apply_post_eq(double* y, int y_length)
 {
     if (!y || y_length <= 0) return;
 
@@ -1005,6 +1955,46 @@ static void apply_post_eq(double* y, int y_length)
     }
 }
 
+// ============================================================
+// RenderSession — インクリメンタル再レンダリング用の常駐状態
+//
+// エディタでの編集は大半が「1ノートのピッチ点が動いた」程度であり、
+// 全ノートの synthesize_note_impl をやり直すのは無駄が大きい。
+// 直前の execute_render が構築した prepass / note_bufs /
+// full_song_buffer をここに保持し、execute_render_incremental が
+// 変更ノート（+クロスフェード隣接ノート）だけを合成し直す。
+//
+// 書き込みフェーズ（パス2-B）は純粋なメモリ操作なので毎回全体を
+// やり直しても5分曲で数十ms — 合成フェーズの削減が本命。
+// ============================================================
+
+struct RenderSession {
+    bool                             valid = false;
+    int                              note_count = 0;
+    int                              mode_flag  = 0;
+    int                              fft_size   = 0;
+    int                              spec_bins  = 0;
+    int64_t                          total_samples      = 0;
+    int64_t                          pre_buffer_samples = 0;
+    int64_t                          buffer_total       = 0;
+    std::vector<double>              note_global_time;
+    std::vector<double>              full_song_buffer;
+
+    // ノートバッファはセッション所有のアリーナ1本から切り出す。
+    // パス1の note_samples 集計で総量が確定しているため、ノートごとに
+    // vector を個別確保する必要がない（従来はプレビューのたびに
+    // ノート数ぶんの malloc + ゼロ初期化が走っていた）。
+    // note_arena は縮小しないので、編集→プレビューの繰り返しは
+    // 2回目以降アロケーションフリーになる。
+    // note_bufs[idx] はアリーナ内の先頭ポインタ（非 RENDERABLE は nullptr）。
+    std::vector<double>              note_arena;
+    std::vector<double*>             note_bufs;
+    std::vector<NotePrepass>         prepass;
+};
+
+static RenderSession g_render_session;
+static VoseMutex     g_render_session_mutex;
+
 // execute_render の並列合成ラムダを自由関数に昇格。
 // vose_streaming.cpp の synth_loop() からも呼べる。
 // ============================================================
@@ -1015,11 +2005,21 @@ struct SynthNoteParams {
     int                fft_size;
     int                spec_bins;
     double             global_time_sec = 0.0;  // 曲先頭からのオフセット（ビブラート位相連続化）
+
+    // 品質ティア (ストリーミングのガバナーが設定。レンダリングは常に 0):
+    //   0 = フル品質
+    //   1 = ポストEQ省略
+    //   2 = + 帯気変調省略（D4C の ap をそのまま使用）
+    //   3 = + Dio 解析ティアへフォールバック
+    int                quality_tier = 0;
 };
 
 static const OtoEntry kDefaultOto = {};
 
-void synthesize_note_impl(const SynthNoteParams& p, std::vector<double>& note_buf)
+// note_buf は pp.note_samples サンプル分の書き込み先。ゼロ初期化は
+// 不要（VOSE_Synthesis → SynthesisWithContext が出力バッファを
+// 先頭でゼロクリアしてから overlap-add する）。
+void synthesize_note_impl(const SynthNoteParams& p, double* note_buf)
 {
     const NotePrepass& pp    = p.pp;
     NoteEvent&         n     = p.n;
@@ -1034,91 +2034,215 @@ void synthesize_note_impl(const SynthNoteParams& p, std::vector<double>& note_bu
     const int     output_frames = static_cast<int>(note_ms / kFramePeriod);
     const OtoEntry& current_oto = pp.has_oto ? pp.oto : kDefaultOto;
 
-    auto cache_cur = get_or_analyze(pp.ev, fft_size, spec_bins);
+    // ティア3以降はノート単位で Dio 解析ティアを強制する
+    const int quality_override = (p.quality_tier >= 3) ? 0 : -1;
+
+    auto cache_cur = get_or_analyze(pp.ev, fft_size, spec_bins, quality_override);
 
     // フォルマント追従用: 音源の基準F0（解析時の有声フレーム平均）を計算
     // これを各フレームのF0と比較してスペクトルの引き伸ばし量を決める
     double base_f0 = 0.0;
     {
         int voiced = 0;
+        const double* src_f0 = cache_cur->f0_data();
         for (int j = 0; j < cache_cur->length; ++j) {
-            if (cache_cur->f0[j] > 50.0) { base_f0 += cache_cur->f0[j]; ++voiced; }
+            if (src_f0[j] > 50.0) { base_f0 += src_f0[j]; ++voiced; }
         }
         base_f0 = (voiced > 0) ? base_f0 / voiced : 220.0;
     }
 
-    tl_scratch.ensure_f0(output_frames);
+    // ステージ別統計: 境界でタイムスタンプを取るだけ（ノートあたり
+    // steady_clock 呼び出し5回。合成コストに対して誤差レベル）
+    const uint64_t t_spec = stats_now_ns();
+
+    tl_scratch.prepare_curves(n, output_frames);
     tl_scratch.ensure_spec(output_frames, spec_bins);
 
     // ----------------------------------------------------------------
     // ステップ1: cur スペクトルを DSP 込みで書き込む
     // (blend_transition_spectra より先に実行する必要がある)
+    //
+    // ロングトーンでは map_time が多数の出力フレームを同一ソース
+    // フレームへ写すため、exp 展開（decode_cache_row）はソースフレーム
+    // が変わった時だけ行い、以降は展開済みの base 行から供給する。
+    // さらに DSP が完全に素通し（gender/formant/tension/breath すべて
+    // 閾値未満）でブレンド対象外のフレームは、行ポインタを共有するだけ
+    // でコピー自体を省略する。ブレンドは cur の先頭 kTransitionFrames
+    // 行を in-place で書き換えるため、その区間は必ず専有行にする。
     // ----------------------------------------------------------------
+    const int no_share_head = pp.prev_ev
+        ? std::min(kTransitionFrames, output_frames) : 0;
+
+    int     base_frame  = -1;       // spec_base に展開済みのソースフレーム
+    double* shared_sr   = nullptr;  // 共有中の素通し行（無ければ nullptr）
+    double* shared_ar   = nullptr;
+
     for (int j = 0; j < output_frames; ++j) {
         const double t_out_ms = j * kFramePeriod;
         const double t_src_ms = map_time(t_out_ms, current_oto, src_ms, note_ms);
         const int src_frame   = clamp(
             static_cast<int>(t_src_ms / kFramePeriod), 0, cache_cur->length-1);
 
-        double* sr = tl_scratch.spec_ptrs[j];
-        double* ar = tl_scratch.ap_ptrs  [j];
-        std::copy_n(&cache_cur->flat_spec[static_cast<size_t>(src_frame)*spec_bins],
-                    spec_bins, sr);
-        std::copy_n(&cache_cur->flat_ap  [static_cast<size_t>(src_frame)*spec_bins],
-                    spec_bins, ar);
-
-        tl_scratch.f0[j] = n.pitch_curve
-            ? resample_curve(n.pitch_curve, n.pitch_length, j, output_frames)
-            : 440.0;
-        const double gender  = n.gender_curve
-            ? resample_curve(n.gender_curve,  n.pitch_length, j, output_frames) : 0.5;
-        const double tension = n.tension_curve
-            ? resample_curve(n.tension_curve, n.pitch_length, j, output_frames) : 0.5;
-        const double breath  = n.breath_curve
-            ? resample_curve(n.breath_curve,  n.pitch_length, j, output_frames) : 0.5;
+        if (src_frame != base_frame) {
+            decode_cache_row(*cache_cur, src_frame,
+                             tl_scratch.spec_base.data(), tl_scratch.ap_base.data());
+            base_frame = src_frame;
+            shared_sr  = nullptr;
+            shared_ar  = nullptr;
+        }
+
+        // 制御カーブは prepare_curves で一括リサンプリング済み（unit-stride 読み）
+        const double gender  = tl_scratch.gender_c [j];
+        const double tension = tl_scratch.tension_c[j];
+        const double breath  = tl_scratch.breath_c [j];
 
         // フォルマント追従: 現フレームF0 / 音源基準F0 を渡す
         // 高音域ほど > 1.0 になり、スペクトル包絡が引き伸ばされて声がこもらない
         const double f0_ratio = (base_f0 > 0.0) ? tl_scratch.f0[j] / base_f0 : 1.0;
+
+        // apply_gender_shift / apply_tension_breath の no-op 判定と同条件
+        const double gender_ratio  = std::exp((gender - 0.5) * 0.4 * std::log(2.0));
+        const double formant_ratio = (f0_ratio > 0.0) ? std::pow(f0_ratio, 0.5) : 1.0;
+        const bool   neutral =
+            std::abs(gender_ratio * formant_ratio - 1.0) < 1e-4 &&
+            std::abs(tension - 0.5) <= 1e-4 &&
+            std::abs(breath  - 0.5) <= 1e-4;
+
+        if (neutral && j >= no_share_head) {
+            // 素通しフレーム: 最初の1枚だけ専有行に複製し、以降は共有
+            if (!shared_sr) {
+                shared_sr = tl_scratch.spec_ptrs[j];
+                shared_ar = tl_scratch.ap_ptrs  [j];
+                std::copy_n(tl_scratch.spec_base.data(), spec_bins, shared_sr);
+                std::copy_n(tl_scratch.ap_base.data(),   spec_bins, shared_ar);
+            } else {
+                tl_scratch.spec_ptrs[j] = shared_sr;
+                tl_scratch.ap_ptrs  [j] = shared_ar;
+            }
+            continue;
+        }
+
+        double* sr = tl_scratch.spec_ptrs[j];
+        double* ar = tl_scratch.ap_ptrs  [j];
+        std::copy_n(tl_scratch.spec_base.data(), spec_bins, sr);
+        std::copy_n(tl_scratch.ap_base.data(),   spec_bins, ar);
         apply_gender_shift(sr, spec_bins, gender, tl_scratch.spec_tmp.data(), f0_ratio);
         apply_tension_breath(sr, ar, spec_bins, tension, breath);
     }
 
     // ----------------------------------------------------------------
-    // ステップ2: prev スペクトルを scratch_prev に展開してブレンド
+    // ステップ2: prev スペクトルの末尾だけを scratch_prev に展開してブレンド
     // (cur が書き終わった後でないと blend の cur 側がゼロになる)
     // ----------------------------------------------------------------
     if (pp.prev_ev) {
-        auto cache_prev = get_or_analyze(pp.prev_ev, fft_size, spec_bins);
-        copy_cache_to_scratch_prev(*cache_prev);
+        auto cache_prev = get_or_analyze(pp.prev_ev, fft_size, spec_bins,
+                                         quality_override);
+        const int tail = std::min({kTransitionFrames, cache_prev->length,
+                                   output_frames});
+        copy_cache_tail_to_scratch_prev(*cache_prev, tail);
         blend_transition_spectra(
             tl_scratch.spec_ptrs.data(), tl_scratch.ap_ptrs.data(), output_frames,
             tl_scratch.spec_ptrs_prev.data(), tl_scratch.ap_ptrs_prev.data(),
-            cache_prev->length, spec_bins, kTransitionFrames);
+            tail, spec_bins, kTransitionFrames);
     }
 
-    smooth_f0_gaussian(tl_scratch.f0.data(), output_frames);
+    const uint64_t t_f0 = stats_now_ns();
 
-    // ビブラートカーブが NoteEvent にあれば使用、なければデフォルト (depth=1.0, rate=6Hz)
-    // NoteEvent 側に vibrato_depth_curve / vibrato_rate_curve / vibrato_curve_length
-    // フィールドを追加した場合はそのまま渡せる。未定義なら nullptr で問題ない。
-    const double* vib_depth = (n.vibrato_depth_curve && n.vibrato_curve_length > 0)
-                              ? n.vibrato_depth_curve : nullptr;
-    const double* vib_rate  = (n.vibrato_rate_curve  && n.vibrato_curve_length > 0)
-                              ? n.vibrato_rate_curve  : nullptr;
-    const int     vib_clen  = n.vibrato_curve_length > 0 ? n.vibrato_curve_length : 0;
+    smooth_f0_gaussian(tl_scratch.f0.data(), output_frames);
 
+    // ビブラートカーブも prepare_curves でフレーム長に展開済み
+    // （NoteEvent 側に無ければ nullptr を渡してデフォルト動作）
     apply_vibrato(tl_scratch.f0.data(), output_frames, kFramePeriod,
-                  p.global_time_sec, vib_depth, vib_rate, vib_clen);
+                  p.global_time_sec,
+                  tl_scratch.has_vib_depth ? tl_scratch.vib_depth_c.data() : nullptr,
+                  tl_scratch.has_vib_rate  ? tl_scratch.vib_rate_c.data()  : nullptr);
+
+    const uint64_t t_world = stats_now_ns();
 
-    note_buf.assign(static_cast<size_t>(note_samples), 0.0);
     VOSE_Synthesis(tl_scratch.f0.data(), output_frames,
                    tl_scratch.spec_ptrs.data(), tl_scratch.ap_ptrs.data(),
                    fft_size, kFramePeriod, pp.ev->fs,
-                   static_cast<int>(note_samples), note_buf.data());
+                   static_cast<int>(note_samples), note_buf,
+                   /*flat_ap=*/p.quality_tier >= 2);
+
+    const uint64_t t_posteq = stats_now_ns();
 
     // ポストEQ: WORLD出力の金属的倍音・箱鳴り補正、高域補強
-    apply_post_eq(note_buf.data(), static_cast<int>(note_samples));
+    // （品質ティア1以降は省略）
+    if (p.quality_tier < 1)
+        apply_post_eq(note_buf, static_cast<int>(note_samples));
+
+    g_engine_stats.synth_notes.fetch_add(1, std::memory_order_relaxed);
+    g_engine_stats.synth_spectral_ns.fetch_add(t_f0 - t_spec,
+                                               std::memory_order_relaxed);
+    g_engine_stats.synth_f0_ns.fetch_add(t_world - t_f0,
+                                         std::memory_order_relaxed);
+    g_engine_stats.synth_world_ns.fetch_add(t_posteq - t_world,
+                                            std::memory_order_relaxed);
+    g_engine_stats.synth_posteq_ns.fetch_add(stats_now_ns() - t_posteq,
+                                             std::memory_order_relaxed);
+}
+
+// vector 版: ストリーミング (synth_loop) とセグメントレンダが使う。
+// 合成結果で全サンプル上書きされるため resize のみでゼロ埋めはしない。
+void synthesize_note_impl(const SynthNoteParams& p, std::vector<double>& note_buf)
+{
+    if (p.pp.state != NoteState::RENDERABLE) return;
+    note_buf.resize(static_cast<size_t>(p.pp.note_samples));
+    synthesize_note_impl(p, note_buf.data());
+}
+
+// ============================================================
+// write_notes_to_song_buffer  (旧 execute_render パス2-B)
+//
+// 合成済み note_bufs を full_song_buffer へ順次書き込む。
+// 書き込みオフセットはノート順に依存するため常にシングルスレッドで
+// 先頭から流す。純粋なメモリ操作なので全曲やり直しても十分速く、
+// execute_render と execute_render_incremental の両方から使う。
+// ============================================================
+static void write_notes_to_song_buffer(RenderSession& ses)
+{
+    std::fill(ses.full_song_buffer.begin(), ses.full_song_buffer.end(), 0.0);
+
+    int64_t current_offset     = ses.pre_buffer_samples;
+    bool    last_note_rendered = false;
+
+    for (int idx = 0; idx < ses.note_count; ++idx) {
+        const NotePrepass& pp = ses.prepass[idx];
+
+        switch (pp.state) {
+        case NoteState::INVALID:
+        case NoteState::NO_VOICE:
+            last_note_rendered = false;
+            if (pp.state == NoteState::NO_VOICE) current_offset += pp.note_samples;
+            continue;
+        case NoteState::RENDERABLE:
+            break;
+        }
+
+        const int64_t note_samples  = pp.note_samples;
+        const OtoEntry& current_oto = pp.has_oto ? pp.oto : kDefaultOto;
+
+        const int64_t pre_samples     =
+            static_cast<int64_t>(current_oto.preutterance * kFs / 1000.0);
+        // overlap: oto.ini の overlap フィールドが存在する場合に有効。
+        const int64_t overlap_samples =
+            static_cast<int64_t>(current_oto.overlap * kFs / 1000.0);
+        const int64_t base_offset  = last_note_rendered
+                                     ? current_offset - kCrossfadeSamples
+                                     : current_offset;
+        const int64_t write_offset = std::max<int64_t>(0, base_offset - pre_samples);
+        const int     xfade        = last_note_rendered ? kCrossfadeSamples : 0;
+
+        apply_crossfade(ses.full_song_buffer, ses.buffer_total,
+                        ses.note_bufs[idx], note_samples,
+                        write_offset, xfade, overlap_samples);
+
+        current_offset += last_note_rendered
+                          ? note_samples - kCrossfadeSamples
+                          : note_samples;
+        last_note_rendered = true;
+    }
 }
 
 // ============================================================
@@ -1127,7 +2251,198 @@ void synthesize_note_impl(const SynthNoteParams& p, std::vector<double>& note_bu
 
 extern "C" {
 
-void init_official_engine() { register_all_embedded_voices(); }
+// ============================================================
+// 解析キャッシュのプリウォーム
+//
+// build_analysis_cache（Harvest + CheapTrick + D4C）は従来、
+// 各音素に最初に触れた synthesize_note_impl の中で遅延実行されて
+// いたため、バンク読み込み直後の初回再生が音素ごとに詰まっていた。
+// 登録済み音素の解析をワーカープールに投げておけば、ユーザーが
+// まだ編集している間に全コアでキャッシュが温まる。
+// get_or_analyze は二重チェック付きなので、プリウォームと実レンダ
+// リングが同じ音素に同時に触れても解析が二重に走ることはない。
+// ============================================================
+
+static void prewarm_voice_async(std::shared_ptr<const EmbeddedVoice> ev)
+{
+    if (!ev) return;
+    vose_worker_pool().submit([ev] {
+        const int fft_size = default_fft_size(kFs);
+        get_or_analyze(ev, fft_size, fft_size / 2 + 1);
+    });
+}
+
+DLLEXPORT void prewarm_analysis_cache(const char** phonemes, int count)
+{
+    if (!phonemes || count <= 0) return;
+    for (int i = 0; i < count; ++i)
+        prewarm_voice_async(find_voice_ref(phonemes[i]));
+}
+
+// ============================================================
+// セッションマニフェスト / ウォームキャッシュ プリロード
+//
+// clear_engine_cache の逆向きが無かったため、エディタ再起動後の
+// 初回再生は音素ごとに hash + stat + ディスク層ロードを合成スレッド上で
+// 直列に払っていた。save_engine_session が終了時に「どのキーが
+// ホットだったか」を cache/session.manifest に書き残し、
+// preload_engine_cache が起動時にディスクキャッシュ (.vsf/.vsc) から
+// LRU をワーカープールで並列再充填する。解析は一切走らない
+// （層が無いキーはスキップし、通常のプリウォームに任せる）ので、
+// プリロードのコストは純粋なファイルI/Oだけになる。
+// ============================================================
+
+static std::string session_manifest_path() {
+    return get_cache_dir() + "/session.manifest";
+}
+
+// キー1件をディスク層から読み込み LRU へ格納する。
+// 既に常駐、または読み込み成功で true。
+static bool preload_cache_key(const std::string& key, int spec_bins)
+{
+    // プレビューティアのキーは "#dio" サフィックス付き
+    // （get_or_analyze / ディスク側 "_dio" と同じ規約）
+    const bool preview = key.size() > 4 &&
+                         key.compare(key.size() - 4, 4, "#dio") == 0;
+    const std::string path = preview ? key.substr(0, key.size() - 4) : key;
+
+    {   // 既に常駐していれば読み直さない
+        VoseUniqueLock rlock(g_analysis_cache_mutex);
+        if (g_analysis_cache.get(key)) return true;
+    }
+
+    std::string h_str = generate_cache_hash(path);
+    if (preview) h_str += "_dio";
+
+    const uint64_t t_load = stats_now_ns();
+    auto layer = load_f0_layer(f0_layer_path(h_str));
+    if (!layer ||
+        !load_spec_layer_into(spec_layer_path(h_str, spec_bins), *layer,
+                              spec_bins))
+        return false;
+
+    g_engine_stats.disk_load_bytes.fetch_add(
+        static_cast<uint64_t>(layer->length) * 2 * sizeof(double) +
+        static_cast<uint64_t>(layer->length) * layer->spec_bins * 2 * sizeof(float),
+        std::memory_order_relaxed);
+    g_engine_stats.disk_load_ns.fetch_add(stats_now_ns() - t_load,
+                                          std::memory_order_relaxed);
+
+    VoseUniqueLock wlock(g_analysis_cache_mutex);
+    if (!g_analysis_cache.get(key))
+        g_analysis_cache.put(
+            key, std::shared_ptr<const AnalysisCache>(std::move(layer)));
+    return true;
+}
+
+DLLEXPORT void save_engine_session(void)
+{
+    const std::vector<std::string> keys = g_analysis_cache.keys();
+
+    const std::string dst = session_manifest_path();
+    const std::string tmp = dst + ".tmp";
+    FILE* fp = fopen(tmp.c_str(), "wb");
+    if (!fp) return;
+
+    bool ok = std::fprintf(fp, "VOSE-SESSION 1\n") > 0;
+    for (const auto& k : keys)
+        ok = ok && std::fprintf(fp, "%s\n", k.c_str()) > 0;
+    atomic_write_finish(fp, ok, tmp, dst);
+}
+
+DLLEXPORT int preload_engine_cache(const char** phonemes, int count)
+{
+    std::vector<std::string> keys;
+    if (phonemes && count > 0) {
+        keys.reserve(count);
+        for (int i = 0; i < count; ++i)
+            if (phonemes[i]) keys.emplace_back(phonemes[i]);
+    } else {
+        // 引数なし: 前回セッションのマニフェストから復元する
+        std::ifstream in(session_manifest_path());
+        std::string line;
+        if (!in || !std::getline(in, line) || line != "VOSE-SESSION 1")
+            return 0;
+        while (std::getline(in, line))
+            if (!line.empty()) keys.push_back(line);
+    }
+    if (keys.empty()) return 0;
+
+    const int fft_size  = default_fft_size(kFs);
+    const int spec_bins = fft_size / 2 + 1;
+
+    // 1キー=1タスクでプールへ投入し、ディスクI/Oのレイテンシを重ねる。
+    // 完了を待ってから返るので、呼び出し側は戻った時点で初回ノートを
+    // キャッシュヒットで引ける。
+    std::atomic<int> loaded{0};
+    TaskGroup tg;
+    for (const std::string& key : keys) {
+        tg.run(vose_worker_pool(), [&loaded, key, spec_bins] {
+            if (preload_cache_key(key, spec_bins))
+                loaded.fetch_add(1, std::memory_order_relaxed);
+        });
+    }
+    tg.wait();
+    return loaded.load(std::memory_order_relaxed);
+}
+
+// ============================================================
+// エンジン統計 (get_engine_stats / reset_engine_stats)
+//
+// カウンタ群のスナップショットを C 構造体へ詰め替える。読み出しは
+// relaxed なので個々のフィールドは正確だがフィールド間の瞬間的な
+// 一貫性は保証しない（統計用途には十分）。
+// ============================================================
+
+DLLEXPORT void get_engine_stats(VoseEngineStats* out)
+{
+    if (!out) return;
+    const auto ld = [](const std::atomic<uint64_t>& a) {
+        return a.load(std::memory_order_relaxed);
+    };
+    out->cache_hits        = ld(g_engine_stats.cache_hits);
+    out->cache_misses      = ld(g_engine_stats.cache_misses);
+    out->cache_evictions   = ld(g_engine_stats.cache_evictions);
+    out->cache_entries     = g_analysis_cache.size();
+    out->disk_load_bytes   = ld(g_engine_stats.disk_load_bytes);
+    out->disk_load_ns      = ld(g_engine_stats.disk_load_ns);
+    out->disk_save_bytes   = ld(g_engine_stats.disk_save_bytes);
+    out->disk_save_ns      = ld(g_engine_stats.disk_save_ns);
+    out->synth_notes       = ld(g_engine_stats.synth_notes);
+    out->synth_spectral_ns = ld(g_engine_stats.synth_spectral_ns);
+    out->synth_f0_ns       = ld(g_engine_stats.synth_f0_ns);
+    out->synth_world_ns    = ld(g_engine_stats.synth_world_ns);
+    out->synth_posteq_ns   = ld(g_engine_stats.synth_posteq_ns);
+    out->stream_underruns  = ld(g_engine_stats.stream_underruns);
+}
+
+DLLEXPORT void reset_engine_stats(void)
+{
+    auto& s = g_engine_stats;
+    for (std::atomic<uint64_t>* a : {
+             &s.cache_hits, &s.cache_misses, &s.cache_evictions,
+             &s.disk_load_bytes, &s.disk_load_ns,
+             &s.disk_save_bytes, &s.disk_save_ns,
+             &s.synth_notes, &s.synth_spectral_ns, &s.synth_f0_ns,
+             &s.synth_world_ns, &s.synth_posteq_ns,
+             &s.stream_underruns })
+        a->store(0, std::memory_order_relaxed);
+}
+
+void init_official_engine() {
+    register_all_embedded_voices();
+    // ワーカープールをここで起動しておく（初回レンダリング時の
+    // スレッド生成スパイクを避ける）
+    vose_worker_pool();
+
+    // 登録済み音素の解析をバックグラウンドで開始しておく。
+    // 投げるだけで戻るため呼び出し側（GUI起動）はブロックしない。
+    const auto snap = voice_snapshot();
+    snap->for_each([](const std::string&,
+                      const std::shared_ptr<const EmbeddedVoice>& ev) {
+        prewarm_voice_async(ev);
+    });
+}
 
 DLLEXPORT void load_embedded_resource(const char* phoneme,
                                       const int16_t* raw_data, int sample_count)
@@ -1136,18 +2451,110 @@ DLLEXPORT void load_embedded_resource(const char* phoneme,
 
     auto ev = std::make_shared<EmbeddedVoice>();
     ev->fs = kFs;
-    ev->waveform.resize(sample_count);
-    for (int i = 0; i < sample_count; ++i)
-        ev->waveform[i] = static_cast<double>(raw_data[i]) * kInv32768;
+    // int16 のままコピーして保持する（double 展開は解析時に遅延）。
+    // 常駐コストは従来の 1/4 になる。呼び出し側のバッファ寿命に
+    // 依存しないよう、ビューではなく所有コピーにする。
+    ev->raw_store.assign(raw_data, raw_data + sample_count);
+    ev->raw_length = sample_count;
+    ev->path       = phoneme;
 
     VoseUniqueLock clock(g_analysis_cache_mutex);
     VoseUniqueLock wlock(g_voice_db_mutex);
     // パス文字列キーでキャッシュを無効化（再ロード時も確実にヒット）
     g_analysis_cache.erase(phoneme);
-    ev->path = phoneme;
-    g_voice_db[phoneme] = std::move(ev);
+    // copy-on-write: 現行スナップショットを複製して差し替える
+    auto next = std::make_shared<VoiceMap>(*voice_snapshot());
+    next->insert(phoneme, std::move(ev));
+    std::atomic_store_explicit(&g_voice_db_store,
+        std::shared_ptr<const VoiceMap>(std::move(next)),
+        std::memory_order_release);
 }
 
+// ============================================================
+// load_voicebank_pack — パック音源バンク (.vpk) の mmap 登録
+//
+// modules/tools/pack_all_voices.py --vpk が生成する
+// 「VoseBankHeader + VoseBankEntry[] + 連結 int16 PCM」の
+// フラット形式を mmap し、各エントリをコピーせずビューのまま
+// g_voice_db に登録する。起動コストはインデックス走査だけで、
+// 波形の double 変換は解析の初回タッチまで起きない。
+// マッピングはビューを持つ最後の EmbeddedVoice と共に解放される。
+// ============================================================
+DLLEXPORT int load_voicebank_pack(const char* path)
+{
+    if (!path) return 0;
+    auto map = MmapFile::open(path);
+    if (!map || map->size < sizeof(VoseBankHeader)) return 0;
+
+    const VoseBankHeader* hdr =
+        reinterpret_cast<const VoseBankHeader*>(map->data);
+    if (hdr->magic != 0x42534F56u || hdr->version != 1) return 0;
+
+    const size_t index_end = sizeof(VoseBankHeader)
+        + static_cast<size_t>(hdr->entry_count) * sizeof(VoseBankEntry);
+    if (map->size < index_end) return 0;
+
+    const VoseBankEntry* entries = reinterpret_cast<const VoseBankEntry*>(
+        map->data + sizeof(VoseBankHeader));
+    const int16_t* samples =
+        reinterpret_cast<const int16_t*>(map->data + index_end);
+    const size_t total_samples = (map->size - index_end) / sizeof(int16_t);
+
+    // 全エントリを1つの新スナップショットにまとめ、最後に1回だけ
+    // 差し替える（エントリごとのロック往復と公開を避ける）
+    VoseUniqueLock clock(g_analysis_cache_mutex);
+    VoseUniqueLock wlock(g_voice_db_mutex);
+    auto next = std::make_shared<VoiceMap>(*voice_snapshot());
+
+    int registered = 0;
+    for (uint32_t i = 0; i < hdr->entry_count; ++i) {
+        const VoseBankEntry& e = entries[i];
+        // 範囲外を指すエントリは壊れたファイルなのでスキップ
+        if (e.alias[0] == '\0' || e.sample_count == 0 ||
+            static_cast<size_t>(e.sample_offset) + e.sample_count >
+                total_samples)
+            continue;
+
+        // alias は NUL 終端を保証してから文字列化する
+        char name[sizeof(e.alias)];
+        std::memcpy(name, e.alias, sizeof(name));
+        name[sizeof(name) - 1] = '\0';
+
+        auto ev = std::make_shared<EmbeddedVoice>();
+        ev->fs         = e.fs > 0 ? static_cast<int>(e.fs) : kFs;
+        ev->raw_view   = samples + e.sample_offset;
+        ev->raw_length = static_cast<int>(e.sample_count);
+        ev->raw_map    = map;
+        ev->path       = name;
+
+        g_analysis_cache.erase(name);
+        next->insert(name, std::move(ev));
+        ++registered;
+    }
+
+    std::atomic_store_explicit(&g_voice_db_store,
+        std::shared_ptr<const VoiceMap>(std::move(next)),
+        std::memory_order_release);
+    return registered;
+}
+
+// 出力段（BigVGAN + wavwrite）。定義は execute_render の直後。
+static void finalize_and_write(const double* src, int n_src,
+                               int out_fs, int out_bit_depth,
+                               const char* output_path);
+#ifdef VOSE_PRO
+// BigVGAN ポストチェーン本体（全曲でもセグメントでも呼べる）。
+// モデル未ロードなら false を返し、呼び出し側は素通しにする。
+static bool bigvgan_process(const double* src, int n_src,
+                            std::vector<double>& out);
+#endif
+// セグメントレンダリング本体。定義は finalize_and_write の直後。
+static void render_segmented(RenderSession& ses, NoteEvent* notes,
+                             int fft_size, int spec_bins,
+                             int64_t pre_buffer_samples, int64_t total_samples,
+                             int out_fs, int out_bit_depth,
+                             const char* output_path);
+
 // ============================================================
 // execute_render  (並列合成版)
 //
@@ -1175,10 +2582,19 @@ DLLEXPORT void execute_render(NoteEvent* notes, int note_count, const char* outp
 {
     if (!notes || note_count <= 0 || !output_path) return;
 
+    // セッション全体をロック: レンダリング状態（prepass / note_bufs /
+    // full_song_buffer）を execute_render_incremental と共有するため、
+    // 構築中の状態を観測されないようにする
+    VoseUniqueLock session_lock(g_render_session_mutex);
+    RenderSession& ses = g_render_session;
+    ses.valid = false;  // 構築完了まで無効化（途中 return でも安全）
+
     // ================================================================
     // Pro版（Studio Master）の判定とパラメータ設定
+    // mode_flag はビットフラグ: bit0 = Pro、bit1 = セグメントレンダリング
     // ================================================================
-    bool is_pro = (mode_flag == 1);
+    bool is_pro     = (mode_flag & 1) != 0;
+    bool segmented  = (mode_flag & 2) != 0;
     
     // Pro版は 32bit float (または32bit PCM)、無料版は 16bit CD音質
     int out_bit_depth = is_pro ? 32 : 16;
@@ -1187,13 +2603,14 @@ DLLEXPORT void execute_render(NoteEvent* notes, int note_count, const char* outp
     // 最後の wavwrite 前にリサンプリング処理を挟みます。
     int out_fs = kFs; 
 
-    const int fft_size  = GetFFTSizeForCheapTrick(kFs, nullptr);
+    const int fft_size  = default_fft_size(kFs);
     const int spec_bins = fft_size / 2 + 1;
 
     // ----------------------------------------------------------------
     // パス1: NotePrepass 構築（変更なし）
     // ----------------------------------------------------------------
-    std::vector<NotePrepass> prepass(note_count);
+    ses.prepass.assign(note_count, NotePrepass());
+    std::vector<NotePrepass>& prepass = ses.prepass;
     int     max_harvest_len  = 0;
     int64_t total_samples    = 0;
     int     xfade_count      = 0;
@@ -1201,6 +2618,11 @@ DLLEXPORT void execute_render(NoteEvent* notes, int note_count, const char* outp
     double  max_preutterance = 0.0;
     std::shared_ptr<const EmbeddedVoice> last_ev;
 
+    // スナップショットを1回取得し、以降のノート走査はロックなしの
+    // ハッシュルックアップだけにする
+    const auto oto_snap   = oto_snapshot();
+    const auto voice_snap = voice_snapshot();
+
     for (int i = 0; i < note_count; ++i) {
         const int pitch_len = notes[i].pitch_length;
         if (pitch_len <= 0 || pitch_len > kMaxPitchLength) {
@@ -1218,18 +2640,13 @@ DLLEXPORT void execute_render(NoteEvent* notes, int note_count, const char* outp
             total_samples  += ns;
             continue;
         }
-        auto ev = find_voice_ref(notes[i].wav_path);
+        const auto* evp = voice_snap->find(notes[i].wav_path);
+        std::shared_ptr<const EmbeddedVoice> ev = evp ? *evp : nullptr;
 
-        const OtoEntry* found_oto = nullptr;
-        {
-            VoseUniqueLock lock(g_oto_db_mutex);
-            auto oto_it = g_oto_db.find(notes[i].wav_path);
-            if (oto_it != g_oto_db.end()) {
-                found_oto = &oto_it->second;
-                max_preutterance = std::max(max_preutterance,
-                                            found_oto->preutterance);
-            }
-        }
+        const OtoEntry* found_oto = oto_snap->find(notes[i].wav_path);
+        if (found_oto)
+            max_preutterance = std::max(max_preutterance,
+                                        found_oto->preutterance);
 
         if (ev) {
             prepass[i] = NotePrepass(NoteState::RENDERABLE, ns, ev,
@@ -1238,7 +2655,7 @@ DLLEXPORT void execute_render(NoteEvent* notes, int note_count, const char* outp
             if (prev_renderable) ++xfade_count;
             prev_renderable = true;
             last_ev         = ev;
-            const int wav_len     = static_cast<int>(ev->waveform.size());
+            const int wav_len     = ev->length();
             const int harvest_len = GetSamplesForHarvest(ev->fs, wav_len, kFramePeriod);
             if (harvest_len > max_harvest_len) max_harvest_len = harvest_len;
         } else {
@@ -1257,25 +2674,34 @@ DLLEXPORT void execute_render(NoteEvent* notes, int note_count, const char* outp
     const int64_t buffer_total = total_samples + pre_buffer_samples;
 
     tl_scratch.ensure_spec(max_harvest_len, spec_bins);
-    std::vector<double> full_song_buffer(buffer_total, 0.0);
+
+    // ----------------------------------------------------------------
+    // セグメントモード: full_song_buffer を確保せず、スライド窓で
+    // 合成→書き出し→解放を繰り返す。ピークメモリが曲長に依存しない。
+    // RenderSession は構築しない（ses.valid = false のまま）ので、
+    // 直後の execute_render_incremental はフルレンダへフォールバックする。
+    // ----------------------------------------------------------------
+    if (segmented) {
+        render_segmented(ses, notes, fft_size, spec_bins,
+                         pre_buffer_samples, total_samples,
+                         out_fs, out_bit_depth, output_path);
+        return;
+    }
+
+    ses.full_song_buffer.assign(buffer_total, 0.0);
+    std::vector<double>& full_song_buffer = ses.full_song_buffer;
 
     // ----------------------------------------------------------------
     // パス2-A: 各ノートの note_buf を並列合成
     //
     // 設計上の注意:
-    //   tl_scratch は thread_local なので「スレッドごとに独立」だが、
-    //   std::async(launch::async) は実装によってスレッドプールを再利用する。
-    //   同じスレッドが2ノード分の synthesize_note_impl を
-    //   ネストして呼び出すことはないが、プールの枯渇で
-    //   launch::deferred（= メインスレッドで実行）に fallback する実装もある。
-    //   安全のため、1ノート = 1スレッドを明示的に生成する方式にする。
-    //   スレッド数は hardware_concurrency でキャップし、バッチ処理する。
+    //   合成タスクは常駐の WorkStealingPool (vose_thread_pool.h) に投入する。
+    //   従来の「1ノート=1スレッド生成 + hardware_concurrency 個ずつ join」
+    //   方式はバッチ内最長ノートで全コアが待たされる上、スレッド生成コストを
+    //   ノートごとに払っていた。プール方式なら長いノートを引いたワーカー
+    //   以外は残タスクを盗んで消化し続けるため、バリアが消える。
+    //   tl_scratch は thread_local なのでワーカーごとに独立しており安全。
     // ----------------------------------------------------------------
-    const int max_threads = static_cast<int>(
-        std::max(1u, std::thread::hardware_concurrency()));
-
-    std::vector<std::vector<double>> note_bufs(note_count);
-
     // RENDERABLE なノートのインデックスだけ集める
     std::vector<int> renderable_indices;
     renderable_indices.reserve(note_count);
@@ -1283,8 +2709,28 @@ DLLEXPORT void execute_render(NoteEvent* notes, int note_count, const char* outp
         if (prepass[i].state == NoteState::RENDERABLE)
             renderable_indices.push_back(i);
 
+    // ノートバッファをアリーナから切り出す（RenderSession のコメント参照）。
+    // パス1で note_samples は確定済みなので総量を先に合計し、
+    // 足りない場合だけ伸ばす（縮小はしない = 再レンダで再利用）。
+    {
+        int64_t arena_needed = 0;
+        for (const int idx : renderable_indices)
+            arena_needed += prepass[idx].note_samples;
+        if (static_cast<int64_t>(ses.note_arena.size()) < arena_needed)
+            ses.note_arena.resize(static_cast<size_t>(arena_needed));
+
+        ses.note_bufs.assign(note_count, nullptr);
+        int64_t cursor = 0;
+        for (const int idx : renderable_indices) {
+            ses.note_bufs[idx] = ses.note_arena.data() + cursor;
+            cursor += prepass[idx].note_samples;
+        }
+    }
+    std::vector<double*>& note_bufs = ses.note_bufs;
+
     // ノートごとのグローバル時間オフセット（ビブラート位相連続化用）
-    std::vector<double> note_global_time(note_count, 0.0);
+    ses.note_global_time.assign(note_count, 0.0);
+    std::vector<double>& note_global_time = ses.note_global_time;
     {
         double acc_sec = 0.0;
         for (int i = 0; i < note_count; ++i) {
@@ -1294,95 +2740,87 @@ DLLEXPORT void execute_render(NoteEvent* notes, int note_count, const char* outp
         }
     }
 
-    // max_threads ずつバッチ処理
-    // 各スレッドは独立した tl_scratch（thread_local）を持つため競合しない
-    for (int batch_start = 0;
-         batch_start < static_cast<int>(renderable_indices.size());
-         batch_start += max_threads)
+    // 全ノートをプールへ一括投入し、完了を待ち合わせる
+    // 各ワーカーは独立した tl_scratch（thread_local）を持つため競合しない
     {
-        const int batch_end = std::min(
-            batch_start + max_threads,
-            static_cast<int>(renderable_indices.size()));
-
-        std::vector<std::thread> threads;
-        threads.reserve(batch_end - batch_start);
-
-        for (int bi = batch_start; bi < batch_end; ++bi) {
-            const int idx = renderable_indices[bi];
-            threads.emplace_back([&, idx] {
+        TaskGroup tg;
+        for (const int idx : renderable_indices) {
+            tg.run(vose_worker_pool(), [&, idx] {
                 SynthNoteParams p{ prepass[idx], notes[idx], fft_size, spec_bins,
                                    note_global_time[idx] };
                 synthesize_note_impl(p, note_bufs[idx]);
             });
         }
-        for (auto& t : threads) t.join();
+        tg.wait();
     }
 
     // ----------------------------------------------------------------
     // パス2-B: 書き込みフェーズ
+    //
+    // セッション状態を確定させてから write_notes_to_song_buffer で
+    // 順次書き込む（インクリメンタル再レンダリングと共通化）
     // ----------------------------------------------------------------
-    int64_t current_offset     = pre_buffer_samples;
-    bool    last_note_rendered = false;
-
-    for (int idx = 0; idx < note_count; ++idx) {
-        const NotePrepass& pp = prepass[idx];
+    ses.note_count         = note_count;
+    ses.mode_flag          = mode_flag;
+    ses.fft_size           = fft_size;
+    ses.spec_bins          = spec_bins;
+    ses.total_samples      = total_samples;
+    ses.pre_buffer_samples = pre_buffer_samples;
+    ses.buffer_total       = buffer_total;
 
-        switch (pp.state) {
-        case NoteState::INVALID:
-        case NoteState::NO_VOICE:
-            last_note_rendered = false;
-            if (pp.state == NoteState::NO_VOICE) current_offset += pp.note_samples;
-            continue;
-        case NoteState::RENDERABLE:
-            break;
-        }
-
-        const int64_t note_samples = pp.note_samples;
-        const OtoEntry& current_oto = pp.has_oto ? pp.oto : kDefaultOto;
-
-        const int64_t pre_samples     =
-            static_cast<int64_t>(current_oto.preutterance * kFs / 1000.0);
-        // overlap: oto.ini の overlap フィールドが存在する場合に有効。
-        // vose_core.h の OtoEntry に overlap メンバがなければ 0 に変更すること。
-        // (UTAUの標準的な OtoEntry には overlap が存在する)
-        const int64_t overlap_samples =
-            static_cast<int64_t>(current_oto.overlap * kFs / 1000.0);
-        const int64_t base_offset  = last_note_rendered
-                                     ? current_offset - kCrossfadeSamples
-                                     : current_offset;
-        const int64_t write_offset = std::max<int64_t>(0, base_offset - pre_samples);
-        const int     xfade        = last_note_rendered ? kCrossfadeSamples : 0;
-
-        apply_crossfade(full_song_buffer, buffer_total,
-                        note_bufs[idx], note_samples,
-                        write_offset, xfade, overlap_samples);
-
-        current_offset += last_note_rendered
-                          ? note_samples - kCrossfadeSamples
-                          : note_samples;
-        last_note_rendered = true;
-    }
+    write_notes_to_song_buffer(ses);
+    ses.valid = true;
 
     // ----------------------------------------------------------------
-    // BigVGAN ボコーダー処理
-    //
-    // WORLD合成の出力PCM（double[]）をメルスペクトログラムに変換し、
-    // BigVGAN ONNX モデルで高品質PCMに再合成する。
-    //
-    // パイプライン:
-    //   full_song_buffer (WORLD出力, double[])
-    //     → pcm_float (float[], [-1,1] 正規化)
-    //     → mel_filterbank (80bin, win=1024, hop=256, 44100Hz)
-    //     → BigVGAN推論 (256フレームchunk, 25msオーバーラップ)
-    //     → overlap-add → wavwrite
-    //
-    // BigVGANが無効なら従来通り WORLD出力をそのまま wavwrite する。
+    // 出力段: BigVGAN ボコーダー + wavwrite
+    // (execute_render_incremental と共通の finalize_and_write へ分離)
     // ----------------------------------------------------------------
+    finalize_and_write(full_song_buffer.data() + pre_buffer_samples,
+                       static_cast<int>(total_samples),
+                       out_fs, out_bit_depth, output_path);
+}
+
+// ============================================================
+// finalize_and_write — BigVGAN ボコーダー + WAV 書き出し
+//
+// WORLD合成の出力PCM（double[]）をメルスペクトログラムに変換し、
+// BigVGAN ONNX モデルで高品質PCMに再合成する。
+//
+// パイプライン:
+//   src (WORLD出力, double[])
+//     → pcm_float (float[], [-1,1] 正規化)
+//     → mel_filterbank (80bin, win=1024, hop=256, 44100Hz)
+//     → BigVGAN推論 (256フレームchunk, 25msオーバーラップ)
+//     → overlap-add → wavwrite
+//
+// BigVGANが無効なら従来通り WORLD出力をそのまま wavwrite する。
+// ============================================================
+static void finalize_and_write(const double* src, int n_src,
+                               int out_fs, int out_bit_depth,
+                               const char* output_path)
 {
-        const double* src   = full_song_buffer.data() + pre_buffer_samples;
-        const int     n_src = static_cast<int>(total_samples);
+#ifdef VOSE_PRO
+    {
+        std::vector<double> bigvgan_out;
+        if (n_src > 0 && bigvgan_process(src, n_src, bigvgan_out)) {
+            wavwrite(bigvgan_out.data(), n_src, out_fs, out_bit_depth,
+                     output_path);
+            return;
+        }
+    }
+    // BigVGAN無効時（Pro版としてビルドされているがモデル未ロード時）:
+    // WORLD出力をそのまま書き出す
+    wavwrite(src, n_src, out_fs, out_bit_depth, output_path);
+#else
+    // 無印版ビルド時: ONNX関連をすべて無視してWORLD出力をそのまま書き出す
+    wavwrite(src, n_src, out_fs, out_bit_depth, output_path);
+#endif
+}
 
 #ifdef VOSE_PRO
+static bool bigvgan_process(const double* src, int n_src,
+                            std::vector<double>& out)
+{
         if (g_bigvgan_session && n_src > 0) {
             // ----------------------------------------------------------
             // ステップ1: double → float 正規化
@@ -1392,120 +2830,34 @@ DLLEXPORT void execute_render(NoteEvent* notes, int note_count, const char* outp
                 pcm[i] = static_cast<float>(std::clamp(src[i], -1.0, 1.0));
 
             // ----------------------------------------------------------
-            // ステップ2: メルスペクトログラム変換
+            // ステップ2: メルスペクトログラム変換 (vose_mel.cpp)
             //
-            // パラメータ (BigVGAN学習時の標準値):
-            //   sample_rate = 44100
-            //   n_fft       = 1024
-            //   hop_size    = 256
-            //   n_mels      = 80
-            //   fmin        = 0 Hz
-            //   fmax        = 22050 Hz (Nyquist)
+            // パラメータ (BigVGAN学習時の標準値) は vose_mel.h の
+            // kMelNFft=1024 / kMelHop=256 / kMelBands=80。
+            // rdft プランのスレッド使い回し + スパースフィルタバンク +
+            // フレーム並列はモジュール側で行う
             // ----------------------------------------------------------
-            constexpr int   kNFft    = 1024;
-            constexpr int   kHop     = 256;
-            constexpr int   kNMels   = 80;
-            constexpr float kFMin    = 0.0f;
-            constexpr float kFMax    = 22050.0f;
-            constexpr float kSR      = 44100.0f;
-            constexpr float kLogFloor = 1e-5f;  // log(mel) のフロア
-
-            const int n_frames = (n_src + kHop - 1) / kHop;
-
-            // Hann窓
-            std::vector<float> window(kNFft);
-            for (int i = 0; i < kNFft; ++i)
-                window[i] = 0.5f * (1.0f - std::cos(2.0f * static_cast<float>(M_PI) * i / kNFft));
-
-            // メルフィルタバンク行列を構築（n_mels × (n_fft/2+1)）
-            // 正規化: 各フィルタをその帯域幅で割ることで、
-            // 低周波ビンの過大評価を防ぐ（BigVGAN学習時と同じ分布にする）
-            const int spec_bins_fft = kNFft / 2 + 1;
-            auto hz_to_mel = [](float hz) { return 2595.0f * std::log10(1.0f + hz / 700.0f); };
-            auto mel_to_hz = [](float mel) { return 700.0f * (std::pow(10.0f, mel / 2595.0f) - 1.0f); };
-
-            std::vector<std::vector<float>> mel_fb(kNMels, std::vector<float>(spec_bins_fft, 0.0f));
-            {
-                const float mel_min = hz_to_mel(kFMin);
-                const float mel_max = hz_to_mel(kFMax);
-                std::vector<float> mel_pts(kNMels + 2);
-                for (int m = 0; m < kNMels + 2; ++m)
-                    mel_pts[m] = mel_to_hz(mel_min + (mel_max - mel_min) * m / (kNMels + 1));
-
-                for (int m = 0; m < kNMels; ++m) {
-                    const float norm = 2.0f / (mel_pts[m+2] - mel_pts[m]); // 面積正規化
-                    for (int k = 0; k < spec_bins_fft; ++k) {
-                        const float hz = k * kSR / kNFft;
-                        if (hz >= mel_pts[m] && hz <= mel_pts[m+1])
-                            mel_fb[m][k] = norm * (hz - mel_pts[m]) / (mel_pts[m+1] - mel_pts[m]);
-                        else if (hz > mel_pts[m+1] && hz <= mel_pts[m+2])
-                            mel_fb[m][k] = norm * (mel_pts[m+2] - hz) / (mel_pts[m+2] - mel_pts[m+1]);
-                    }
-                }
-            }
-
-            // メルスペクトログラム [n_frames][n_mels]
-            std::vector<std::vector<float>> mel_spec(n_frames, std::vector<float>(kNMels, kLogFloor));
-            {
-                std::vector<float> frame_buf(kNFft, 0.0f);
-                std::vector<float> power(spec_bins_fft);
-                std::vector<float> re(kNFft), im(kNFft);
-
-                for (int t = 0; t < n_frames; ++t) {
-                    const int center = t * kHop;
-                    for (int i = 0; i < kNFft; ++i) {
-                        const int s = center - kNFft/2 + i;
-                        frame_buf[i] = (s >= 0 && s < n_src) ? pcm[s] * window[i] : 0.0f;
-                    }
-
-                    // Cooley-Tukey 基数2 DIT FFT（正しい順序）
-                    // ステップ1: ビット反転並べ替え（これを先にやる）
-                    std::copy(frame_buf.begin(), frame_buf.end(), re.begin());
-                    std::fill(im.begin(), im.end(), 0.0f);
-                    {
-                        int j = 0;
-                        for (int i = 1; i < kNFft; ++i) {
-                            int bit = kNFft >> 1;
-                            for (; j & bit; bit >>= 1) j ^= bit;
-                            j ^= bit;
-                            if (i < j) { std::swap(re[i], re[j]); }
-                        }
-                    }
-                    // ステップ2: バタフライ演算（並べ替え後に実行）
-                    for (int step = 1; step < kNFft; step <<= 1) {
-                        const float ang_base = -static_cast<float>(M_PI) / step;
-                        for (int i = 0; i < kNFft; i += step * 2) {
-                            for (int j = 0; j < step; ++j) {
-                                const float ang = ang_base * j;
-                                const float wr  = std::cos(ang), wi = std::sin(ang);
-                                const float tr  = wr*re[i+j+step] - wi*im[i+j+step];
-                                const float ti  = wr*im[i+j+step] + wi*re[i+j+step];
-                                re[i+j+step] = re[i+j] - tr;
-                                im[i+j+step] = im[i+j] - ti;
-                                re[i+j]     += tr;
-                                im[i+j]     += ti;
-                            }
-                        }
-                    }
-
-                    for (int k = 0; k < spec_bins_fft; ++k)
-                        power[k] = re[k]*re[k] + im[k]*im[k];
+            constexpr int kHop   = kMelHop;
+            constexpr int kNMels = kMelBands;
 
-                    for (int m = 0; m < kNMels; ++m) {
-                        float val = 0.0f;
-                        for (int k = 0; k < spec_bins_fft; ++k)
-                            val += mel_fb[m][k] * power[k];
-                        mel_spec[t][m] = std::log(std::max(val, kLogFloor));
-                    }
-                }
-            }
+            // メルスペクトログラム mel_spec[t * kNMels + m]
+            std::vector<float> mel_spec;
+            const int n_frames = compute_mel_spectrogram(
+                pcm.data(), n_src, mel_spec);
 
             // ----------------------------------------------------------
-            // ステップ3: BigVGAN推論
+            // ステップ3: BigVGAN推論（ダブルバッファ・パイプライン）
             //
             // chunk_frames = 256  → 65536サンプル出力
             // overlap_frames = 25ms @ hop=256 → ceil(25ms*44100/256) = 4フレーム
             // オーバーラップ部は raised-cosine でブレンド
+            //
+            // 旧実装は「mel充填 → Run → オーバーラップアド」を直列に
+            // 回していたため、推論中は CPU 側の前後処理が完全に遊んで
+            // いた。入出力テンソルを2組だけ事前確保して IoBinding で
+            // 束縛し（Run ごとの出力テンソル割り当ても消える）、
+            // チャンク N の Run の裏でチャンク N+1 の mel 充填と
+            // チャンク N-1 以前のブレンドを進める。
             // ----------------------------------------------------------
             constexpr int kChunkFrames   = 256;
             constexpr int kOverlapFrames = 4;   // 25ms相当（実測で十分な連続性）
@@ -1514,39 +2866,66 @@ DLLEXPORT void execute_render(NoteEvent* notes, int note_count, const char* outp
 
             std::vector<float> out_pcm(n_frames * kHop, 0.0f);
 
+            // チャンク開始フレームの列（最終チャンクは末尾フレーム埋め）
+            std::vector<int> starts;
+            for (int t = 0; ; t += kChunkFrames - kOverlapFrames) {
+                starts.push_back(t);
+                if (t + kChunkFrames >= n_frames) break;
+            }
+
             Ort::MemoryInfo mem_info =
                 Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
 
             const char* input_name  = "input_mel";
             const char* output_name = "output_audio";
 
-            std::vector<float> chunk_mel(kNMels * kChunkFrames);
+            const std::array<int64_t, 3> input_shape  = {1, kNMels, kChunkFrames};
+            const std::array<int64_t, 3> output_shape = {1, 1, kChunkSamples};
+
+            // ダブルバッファ: テンソルは自前の float バッファに重ね、
+            // IoBinding で入出力とも固定する
+            struct ChunkSlot {
+                std::vector<float>              mel;
+                std::vector<float>              pcm;
+                Ort::Value                      in_tensor{nullptr};
+                Ort::Value                      out_tensor{nullptr};
+                std::unique_ptr<Ort::IoBinding> binding;
+            };
+            ChunkSlot slots[2];
+            for (ChunkSlot& slot : slots) {
+                slot.mel.resize(static_cast<size_t>(kNMels) * kChunkFrames);
+                slot.pcm.resize(kChunkSamples);
+                slot.in_tensor = Ort::Value::CreateTensor<float>(
+                    mem_info, slot.mel.data(), slot.mel.size(),
+                    input_shape.data(), input_shape.size());
+                slot.out_tensor = Ort::Value::CreateTensor<float>(
+                    mem_info, slot.pcm.data(), slot.pcm.size(),
+                    output_shape.data(), output_shape.size());
+                slot.binding =
+                    std::make_unique<Ort::IoBinding>(*g_bigvgan_session);
+                slot.binding->BindInput(input_name, slot.in_tensor);
+                slot.binding->BindOutput(output_name, slot.out_tensor);
+            }
 
-            for (int t_start = 0; t_start < n_frames; t_start += kChunkFrames - kOverlapFrames) {
-                // メルchunkを [1, 80, 256] に充填（足りない部分は末尾フレームで埋める）
+            // メルchunkを [1, 80, 256] に充填（足りない部分は末尾フレーム埋め）
+            auto pack_chunk = [&](ChunkSlot& slot, int t_start) {
                 for (int t = 0; t < kChunkFrames; ++t) {
                     const int src_t = std::min(t_start + t, n_frames - 1);
                     for (int m = 0; m < kNMels; ++m)
-                        chunk_mel[m * kChunkFrames + t] = mel_spec[src_t][m];
+                        slot.mel[m * kChunkFrames + t] =
+                            mel_spec[static_cast<size_t>(src_t) * kNMels + m];
                 }
+            };
 
-                // ONNX推論
-                std::array<int64_t, 3> input_shape  = {1, kNMels, kChunkFrames};
-                std::array<int64_t, 3> output_shape = {1, 1, kChunkSamples};
-
-                auto input_tensor = Ort::Value::CreateTensor<float>(
-                    mem_info, chunk_mel.data(), chunk_mel.size(),
-                    input_shape.data(), input_shape.size());
-
-                auto outputs = g_bigvgan_session->Run(
-                    Ort::RunOptions{nullptr},
-                    &input_name, &input_tensor, 1,
-                    &output_name, 1);
-
-                const float* chunk_out = outputs[0].GetTensorData<float>();
+            auto run_chunk = [&](ChunkSlot& slot) {
+                g_bigvgan_session->Run(Ort::RunOptions{nullptr},
+                                       *slot.binding);
+            };
 
-                // オーバーラップアド（raised-cosine ブレンド）
-                const int write_sample = t_start * kHop;
+            // オーバーラップアド（raised-cosine ブレンド）
+            auto blend_chunk = [&](const ChunkSlot& slot, int t_start) {
+                const float* chunk_out    = slot.pcm.data();
+                const int    write_sample = t_start * kHop;
                 for (int s = 0; s < kChunkSamples; ++s) {
                     const int out_s = write_sample + s;
                     if (out_s >= static_cast<int>(out_pcm.size())) break;
@@ -1561,29 +2940,329 @@ DLLEXPORT void execute_render(NoteEvent* notes, int note_count, const char* outp
                         out_pcm[out_s] = chunk_out[s];
                     }
                 }
+            };
 
-                // 曲末に達したら終了
-                if (t_start + kChunkFrames >= n_frames) break;
+            // パイプライン本体。推論は別スレッド、充填とブレンドは
+            // このスレッドで進める。ブレンドはチャンク順序依存
+            // （オーバーラップ領域の上書き順）なので直列のまま
+            pack_chunk(slots[0], starts[0]);
+            std::future<void> running = std::async(
+                std::launch::async, run_chunk, std::ref(slots[0]));
+
+            for (size_t c = 0; c < starts.size(); ++c) {
+                ChunkSlot& cur = slots[c % 2];
+
+                // Run(c) の裏で次チャンクの mel を詰める
+                if (c + 1 < starts.size())
+                    pack_chunk(slots[(c + 1) % 2], starts[c + 1]);
+
+                running.get();   // Run(c) 完了
+
+                // Run(c+1) を即座に投げ、その裏で c の出力をブレンド
+                if (c + 1 < starts.size())
+                    running = std::async(std::launch::async, run_chunk,
+                                         std::ref(slots[(c + 1) % 2]));
+
+                blend_chunk(cur, starts[c]);
             }
 
             // ----------------------------------------------------------
-            // ステップ4: BigVGAN出力を double[] に変換して wavwrite
+            // ステップ4: BigVGAN出力を double[] に変換して返す
             // ----------------------------------------------------------
-            std::vector<double> bigvgan_out(n_src);
+            out.resize(n_src);
             for (int i = 0; i < n_src; ++i)
-                bigvgan_out[i] = std::clamp(static_cast<double>(out_pcm[i]), -1.0, 1.0);
+                out[i] = std::clamp(static_cast<double>(out_pcm[i]), -1.0, 1.0);
+            return true;
+        }
+        return false;
+}
+#endif  // VOSE_PRO
 
-            wavwrite(bigvgan_out.data(), n_src, out_fs, out_bit_depth, output_path);
+// ============================================================
+// render_segmented — セグメントレンダリング本体
+//
+// full_song_buffer を曲丸ごと確保する代わりに、タイムラインの
+// スライド窓（数秒分）だけを保持して合成→書き出し→解放を繰り返す。
+// ピークメモリは曲長に依存しなくなる。
+//
+// 縫い目の扱い:
+//   後続ノートは write_offset = current_offset - kCrossfadeSamples
+//   - pre_samples まで手前に書き戻すため、窓の末尾には常に
+//   kCrossfadeSamples + 最大先行発声 分を残してからフラッシュする
+//   （両者の和なので max(...) より厳密に安全）。
+//
+// 書き出しは WavStreamWriter (world/audioio)。変換（クランプ +
+// 16bit時のTPDFディザ）はこのスレッドで行い、fwrite はライターの
+// I/Oスレッドが担当するので、ディスク待ちが次セグメントの合成と
+// 重なる。Pro (32bit) は IEEE float で書く。
+//
+// BigVGAN は通さない（WORLD出力をそのまま書く）:
+//   上記の縫い目保証は WORLD の書き込み窓に対するもの。フラッシュ
+//   単位で bigvgan_process に通すと、境界のメルフレームが STFT
+//   コンテキスト（±kMelNFft/2 サンプル）を失う上、フラッシュ間で
+//   ボコーダ出力のオーバーラップ加算もできないため、境界ごとに
+//   可聴ノイズが乗る。BigVGAN 品質が必要な場合は通常のフルレンダ
+//   （モノリシックパスは全曲に対してチャンク重畳で処理する）を使う。
+// セグメント構築中の状態は RenderSession に残さないため、直後の
+// execute_render_incremental は通常のフルレンダへフォールバックする。
+// ============================================================
+static void render_segmented(RenderSession& ses, NoteEvent* notes,
+                             int fft_size, int spec_bins,
+                             int64_t pre_buffer_samples, int64_t total_samples,
+                             int out_fs, int out_bit_depth,
+                             const char* output_path)
+{
+    const std::vector<NotePrepass>& prepass = ses.prepass;
+    const int note_count = static_cast<int>(prepass.size());
+
+    WavStreamWriter* writer =
+        OpenWavStreamWriter(output_path, out_fs, out_bit_depth);
+    if (!writer) return;
+
+    // フラッシュ目標: 約5秒分たまるごとに書き出す
+    const int64_t kSegmentSamples = static_cast<int64_t>(kFs) * 5;
+
+    int64_t max_pre_samples = 0;
+    for (const auto& pp : prepass)
+        if (pp.has_oto)
+            max_pre_samples = std::max(max_pre_samples,
+                static_cast<int64_t>(pp.oto.preutterance * kFs / 1000.0));
+    const int64_t keep_tail =
+        static_cast<int64_t>(kCrossfadeSamples) + max_pre_samples;
+
+    // 出力対象のタイムライン範囲（先頭の先行発声バッファは捨てる）
+    const int64_t out_begin = pre_buffer_samples;
+    const int64_t out_end   = pre_buffer_samples + total_samples;
+
+    // スライド窓: タイムライン [win_start, win_start + window.size())
+    std::vector<double> window;
+    int64_t win_start = 0;
+    int64_t flushed   = 0;   // タイムライン上の確定済み位置
+
+    auto flush_to = [&](int64_t upto) {
+        upto = std::min(upto, out_end);
+        const int64_t from = std::max(flushed, out_begin);
+        if (upto > from) {
+            // 窓はノートの write_end までしか伸びていない。最終ノートの
+            // 先行発声巻き戻し分や曲末の休符では upto が窓末尾を越える
+            // （休符のみの曲なら窓が空のこともある）ため、不足分を
+            // ゼロで埋めてから読む。
+            if (upto - win_start > static_cast<int64_t>(window.size()))
+                window.resize(static_cast<size_t>(upto - win_start), 0.0);
+            const double* seg = window.data() + (from - win_start);
+            const int     n   = static_cast<int>(upto - from);
+            // WORLD出力を直接書く。BigVGAN はここでは通さない
+            // （バナーコメント参照: フラッシュ境界で破綻する）
+            AppendWavStreamWriter(writer, seg, n);
+        }
+        if (upto > flushed) flushed = upto;
+        // 窓の先頭の確定済み領域を解放する
+        const int64_t drop = flushed - win_start;
+        if (drop > 0) {
+            window.erase(window.begin(),
+                         window.begin() + static_cast<size_t>(drop));
+            win_start = flushed;
+        }
+    };
 
-        } else {
-            // BigVGAN無効時（Pro版としてビルドされているがモデル未ロード時）: WORLD出力をそのまま書き出す
-            wavwrite(src, n_src, out_fs, out_bit_depth, output_path);
+    // ビブラート位相連続化のグローバル時間（通常パスと同じ走査）
+    std::vector<double> note_global_time(note_count, 0.0);
+    {
+        double acc_sec = 0.0;
+        for (int i = 0; i < note_count; ++i) {
+            note_global_time[i] = acc_sec;
+            if (prepass[i].note_samples > 0)
+                acc_sec += static_cast<double>(prepass[i].note_samples) / kFs;
         }
-#else
-        // 無印版ビルド時: ONNX関連をすべて無視してWORLD出力をそのまま書き出す
-        wavwrite(src, n_src, out_fs, out_bit_depth, output_path);
-#endif
     }
+
+    int64_t current_offset     = pre_buffer_samples;
+    bool    last_note_rendered = false;
+
+    // プールのワーカー数ぶんずつ並列合成し、note_buf はチャンク単位で解放
+    const int chunk_size = std::max(1, vose_worker_pool().worker_count());
+    std::vector<std::vector<double>> bufs;
+
+    for (int c0 = 0; c0 < note_count; c0 += chunk_size) {
+        const int c1 = std::min(note_count, c0 + chunk_size);
+
+        bufs.assign(c1 - c0, std::vector<double>());
+        {
+            TaskGroup tg;
+            for (int i = c0; i < c1; ++i) {
+                if (prepass[i].state != NoteState::RENDERABLE) continue;
+                tg.run(vose_worker_pool(), [&, i, c0] {
+                    SynthNoteParams p{ prepass[i], notes[i],
+                                       fft_size, spec_bins,
+                                       note_global_time[i] };
+                    synthesize_note_impl(p, bufs[i - c0]);
+                });
+            }
+            tg.wait();
+        }
+
+        // 窓への書き込みは write_notes_to_song_buffer と同一の走査
+        for (int i = c0; i < c1; ++i) {
+            const NotePrepass& pp = prepass[i];
+            switch (pp.state) {
+            case NoteState::INVALID:
+            case NoteState::NO_VOICE:
+                last_note_rendered = false;
+                if (pp.state == NoteState::NO_VOICE)
+                    current_offset += pp.note_samples;
+                continue;
+            case NoteState::RENDERABLE:
+                break;
+            }
+
+            const int64_t note_samples  = pp.note_samples;
+            const OtoEntry& current_oto = pp.has_oto ? pp.oto : kDefaultOto;
+
+            const int64_t pre_samples     =
+                static_cast<int64_t>(current_oto.preutterance * kFs / 1000.0);
+            const int64_t overlap_samples =
+                static_cast<int64_t>(current_oto.overlap * kFs / 1000.0);
+            const int64_t base_offset  = last_note_rendered
+                                         ? current_offset - kCrossfadeSamples
+                                         : current_offset;
+            const int64_t write_offset =
+                std::max<int64_t>(0, base_offset - pre_samples);
+            const int     xfade = last_note_rendered ? kCrossfadeSamples : 0;
+
+            // 窓をノート末尾まで伸ばす（伸長分はゼロ初期化）
+            const int64_t write_end = write_offset + note_samples;
+            if (write_end > win_start + static_cast<int64_t>(window.size()))
+                window.resize(static_cast<size_t>(write_end - win_start), 0.0);
+
+            apply_crossfade(window, static_cast<int64_t>(window.size()),
+                            bufs[i - c0].data(), note_samples,
+                            write_offset - win_start, xfade, overlap_samples);
+
+            current_offset += last_note_rendered
+                              ? note_samples - kCrossfadeSamples
+                              : note_samples;
+            last_note_rendered = true;
+
+            // 末尾マージンを残して確定分を書き出す
+            if (current_offset - keep_tail - flushed >= kSegmentSamples)
+                flush_to(current_offset - keep_tail);
+        }
+        bufs.clear();   // チャンク分の note_buf を即時解放
+    }
+
+    flush_to(out_end);
+    FinalizeWavStreamWriter(writer);
+}
+
+// ============================================================
+// execute_render_incremental — ダーティノートのみの再レンダリング
+//
+// 直前の execute_render が残した RenderSession を再利用し、
+// [changed_from_idx, changed_to_idx] のノート（とクロスフェードで
+// 隣接する前後1ノート）だけ synthesize_note_impl をやり直す。
+// 書き込みフェーズは write_notes_to_song_buffer で全曲分やり直すが、
+// これは純粋なメモリ操作なので合成に比べ無視できる。
+//
+// セッションが再利用できない場合（初回 / ノート数変化 / ノート長変化 /
+// モード変更）は黙って通常の execute_render にフォールバックする。
+// ============================================================
+DLLEXPORT void execute_render_incremental(NoteEvent* notes, int note_count,
+                                          int changed_from_idx, int changed_to_idx,
+                                          const char* output_path, int mode_flag)
+{
+    if (!notes || note_count <= 0 || !output_path) return;
+
+    {
+        VoseUniqueLock session_lock(g_render_session_mutex);
+        RenderSession& ses = g_render_session;
+
+        const bool session_reusable =
+            ses.valid &&
+            ses.note_count == note_count &&
+            ses.mode_flag  == mode_flag &&
+            changed_from_idx >= 0 && changed_from_idx < note_count &&
+            changed_to_idx   >= changed_from_idx && changed_to_idx < note_count;
+
+        if (session_reusable) {
+            // ----------------------------------------------------------
+            // 変更範囲の prepass を再構築し、再利用可否を検証する。
+            // note_samples（= ノート長）や state が変わっていたら
+            // 後続ノートのオフセットが全部ずれるのでフォールバック。
+            // ----------------------------------------------------------
+            bool offsets_stable = true;
+            const auto oto_snap = oto_snapshot();
+            for (int i = changed_from_idx; i <= changed_to_idx && offsets_stable; ++i) {
+                const int pitch_len = notes[i].pitch_length;
+                NotePrepass fresh;
+                if (pitch_len <= 0 || pitch_len > kMaxPitchLength) {
+                    fresh = NotePrepass(NoteState::INVALID, 0, nullptr);
+                } else {
+                    const int64_t ns = note_samples_safe(pitch_len);
+                    auto ev = notes[i].wav_path ? find_voice_ref(notes[i].wav_path)
+                                                : nullptr;
+                    if (!ev) {
+                        fresh = NotePrepass(NoteState::NO_VOICE, ns, nullptr);
+                    } else {
+                        const OtoEntry* found_oto =
+                            oto_snap->find(notes[i].wav_path);
+                        fresh = NotePrepass(NoteState::RENDERABLE, ns, ev,
+                                            ses.prepass[i].prev_ev, found_oto);
+                    }
+                }
+                if (fresh.state        != ses.prepass[i].state ||
+                    fresh.note_samples != ses.prepass[i].note_samples) {
+                    offsets_stable = false;
+                } else {
+                    ses.prepass[i] = std::move(fresh);
+                }
+            }
+
+            if (offsets_stable) {
+                // 変更範囲の prev_ev をパス1と同じ規則で張り直す。
+                // 再構築時に引き継いだ ses.prepass[i].prev_ev は、前ノートの
+                // wav_path が同一長の別音素に差し替わった場合に旧音源の
+                // ままになる（offsets_stable は state と長さしか見ない）。
+                // 次ノート (changed_to_idx+1) は変更ノートを prev に持つ
+                // ので対象に含める。
+                const int fix_to = std::min(note_count - 1, changed_to_idx + 1);
+                for (int i = changed_from_idx; i <= fix_to; ++i) {
+                    if (ses.prepass[i].state != NoteState::RENDERABLE) continue;
+                    ses.prepass[i].prev_ev =
+                        (i > 0 && ses.prepass[i-1].state == NoteState::RENDERABLE)
+                            ? ses.prepass[i-1].ev : nullptr;
+                }
+
+                // クロスフェード隣接ノートも合成し直す
+                // （前ノートとのブレンド区間・次ノートの prev_ev 由来の
+                //   トランジションが変更ノートに依存するため）
+                const int dirty_from = std::max(0, changed_from_idx - 1);
+                const int dirty_to   = std::min(note_count - 1, changed_to_idx + 1);
+
+                TaskGroup tg;
+                for (int idx = dirty_from; idx <= dirty_to; ++idx) {
+                    if (ses.prepass[idx].state != NoteState::RENDERABLE) continue;
+                    tg.run(vose_worker_pool(), [&, idx] {
+                        SynthNoteParams p{ ses.prepass[idx], notes[idx],
+                                           ses.fft_size, ses.spec_bins,
+                                           ses.note_global_time[idx] };
+                        synthesize_note_impl(p, ses.note_bufs[idx]);
+                    });
+                }
+                tg.wait();
+
+                write_notes_to_song_buffer(ses);
+
+                const bool is_pro = (ses.mode_flag & 1) != 0;
+                finalize_and_write(
+                    ses.full_song_buffer.data() + ses.pre_buffer_samples,
+                    static_cast<int>(ses.total_samples),
+                    kFs, is_pro ? 32 : 16, output_path);
+                return;
+            }
+        }
+    }  // session_lock 解放（execute_render が再取得する）
+
+    execute_render(notes, note_count, output_path, mode_flag);
 }
 
 } // extern "C"
@@ -1593,11 +3272,36 @@ DLLEXPORT void execute_render(NoteEvent* notes, int note_count, const char* outp
 // ============================================================
 #ifdef VOSE_PRO
 namespace {
-    static Ort::Env            g_ort_env{ORT_LOGGING_LEVEL_WARNING, "vose_bigvgan"};
-    static Ort::SessionOptions g_ort_opts;
+    static Ort::Env g_ort_env{ORT_LOGGING_LEVEL_WARNING, "vose_bigvgan"};
+
+    // 選択中の実行プロバイダとウォームアップ設定。
+    // set_bigvgan_options で設定し、次の set_bigvgan_model から適用される
+    static std::string g_bigvgan_provider = "cpu";
+    static bool        g_bigvgan_warmup   = false;
 }
 #endif
 
+// BigVGAN の実行プロバイダとウォームアップを設定する。
+// set_bigvgan_model より前に呼ぶこと（次回ロードから適用される）。
+// provider: "cpu"(デフォルト) / "cuda" / "tensorrt" / "dml" / "coreml"
+//           大文字小文字は区別しない。環境に無いプロバイダを指定しても
+//           CPU にフォールバックしてロード自体は成功する。
+// warmup  : 非0ならロード直後に無音チャンクで推論を1回流し、グラフ
+//           最適化と GPU カーネルコンパイルの遅延を初回エクスポートの
+//           レンダ中から起動時に移す。
+extern "C" DLLEXPORT void set_bigvgan_options(const char* provider, int warmup) {
+#ifdef VOSE_PRO
+    std::lock_guard<VoseMutex> lk(g_bigvgan_mutex);
+    std::string p = provider ? provider : "cpu";
+    std::transform(p.begin(), p.end(), p.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    g_bigvgan_provider = p.empty() ? "cpu" : p;
+    g_bigvgan_warmup   = warmup != 0;
+#else
+    (void)provider; (void)warmup;
+#endif
+}
+
 // BigVGAN ONNXモデルのパスを設定する（init_official_engine から呼ぶ）
 // path が nullptr または空なら BigVGAN を無効化する
 extern "C" DLLEXPORT void set_bigvgan_model(const char* onnx_path) {
@@ -1608,15 +3312,65 @@ extern "C" DLLEXPORT void set_bigvgan_model(const char* onnx_path) {
         return;
     }
     try {
-        g_ort_opts.SetIntraOpNumThreads(
+        // SessionOptions はロードごとに作り直す（グローバル再利用だと
+        // 再ロード時にプロバイダ登録が重複する）
+        Ort::SessionOptions opts;
+        opts.SetIntraOpNumThreads(
             static_cast<int>(std::max(1u, std::thread::hardware_concurrency())));
-        g_ort_opts.SetGraphOptimizationLevel(ORT_ENABLE_ALL);
+        opts.SetGraphOptimizationLevel(ORT_ENABLE_ALL);
+
+        // 実行プロバイダの登録。失敗は致命的ではない —
+        // 登録できなければ ORT が CPU で実行する
+        if (g_bigvgan_provider == "cuda") {
+            try {
+                OrtCUDAProviderOptions cuda_opts{};
+                opts.AppendExecutionProvider_CUDA(cuda_opts);
+            } catch (const std::exception&) { /* CPU フォールバック */ }
+        } else if (g_bigvgan_provider == "tensorrt") {
+            try {
+                OrtTensorRTProviderOptions trt_opts{};
+                opts.AppendExecutionProvider_TensorRT(trt_opts);
+            } catch (const std::exception&) { /* CPU フォールバック */ }
+        } else if (g_bigvgan_provider != "cpu") {
+            // "dml" / "coreml" 等は文字列ベースの汎用APIで登録する
+            try {
+                const std::string name =
+                    g_bigvgan_provider == "dml"    ? "DML" :
+                    g_bigvgan_provider == "coreml" ? "CoreML" :
+                    g_bigvgan_provider;
+                opts.AppendExecutionProvider(name, {});
+            } catch (const std::exception&) { /* CPU フォールバック */ }
+        }
+
 #ifdef _WIN32
         const std::wstring wpath(onnx_path, onnx_path + strlen(onnx_path));
-        g_bigvgan_session = std::make_unique<Ort::Session>(g_ort_env, wpath.c_str(), g_ort_opts);
+        g_bigvgan_session = std::make_unique<Ort::Session>(g_ort_env, wpath.c_str(), opts);
 #else
-        g_bigvgan_session = std::make_unique<Ort::Session>(g_ort_env, onnx_path, g_ort_opts);
+        g_bigvgan_session = std::make_unique<Ort::Session>(g_ort_env, onnx_path, opts);
 #endif
+
+        if (g_bigvgan_warmup && g_bigvgan_session) {
+            // 無音メル（ログフロア）で1チャンク流す。初回 Run にかかる
+            // グラフ最適化・カーネルコンパイルをここで吸収する
+            try {
+                constexpr int kWarmFrames = 256;
+                std::vector<float> mel(
+                    static_cast<size_t>(kMelBands) * kWarmFrames,
+                    std::log(1e-5f));
+                const std::array<int64_t, 3> shape =
+                    {1, kMelBands, kWarmFrames};
+                Ort::MemoryInfo mem_info = Ort::MemoryInfo::CreateCpu(
+                    OrtArenaAllocator, OrtMemTypeDefault);
+                auto in_tensor = Ort::Value::CreateTensor<float>(
+                    mem_info, mel.data(), mel.size(),
+                    shape.data(), shape.size());
+                const char* in_name  = "input_mel";
+                const char* out_name = "output_audio";
+                g_bigvgan_session->Run(Ort::RunOptions{nullptr},
+                                       &in_name, &in_tensor, 1,
+                                       &out_name, 1);
+            } catch (...) { /* ウォームアップ失敗はロード成功を妨げない */ }
+        }
     } catch (...) {
         g_bigvgan_session.reset();
     }
@@ -0,0 +1,197 @@
+// vose_mel.cpp
+// ============================================================
+// BigVGAN 用メルスペクトログラム フロントエンド
+//
+// 旧実装は bigvgan_process 内に手書きの基数2 float FFT を抱え、
+// バタフライループの中で毎フレーム sin/cos を計算し直していた
+// （約170フレーム/秒をシングルスレッドで）。メル変換だけで
+// ONNX 推論と同程度の時間を食っていたため、以下に置き換える:
+//
+//   1. world/fft.h の大浦版 rdft を使う。ip/w の回転因子テーブルは
+//      プラン作成時に1回だけ計算され、フレームごとの三角関数呼び出し
+//      が消える。プランは in/out バッファごと thread_local に保持。
+//   2. メルフィルタバンクは構築時点で約95%がゼロ（三角フィルタの
+//      非ゼロ区間は連続）なので、「開始ビン + 連続係数列」の
+//      スパース表現で持ち、内積を非ゼロ区間だけ走らせる。
+//   3. STFT のフレームループはフレーム間で完全に独立なので、
+//      ワーカープールでレンジ分割して並列化する。
+//
+// フィルタ形状・正規化・ログフロアは旧実装と同一（BigVGAN 学習時の
+// 分布を変えないこと）。
+// ============================================================
+
+#include "vose_mel.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "world/fft.h"
+#include "vose_thread_pool.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+
+constexpr float kFMin     = 0.0f;
+constexpr float kFMax     = 22050.0f;   // Nyquist
+constexpr float kSR       = 44100.0f;
+constexpr float kLogFloor = 1e-5f;      // log(mel) のフロア
+constexpr int   kSpecBins = kMelNFft / 2 + 1;
+
+// ============================================================
+// スパースメルフィルタバンク
+//
+// 三角フィルタの非ゼロ区間は連続なので、バンドごとに
+// 「最初の非ゼロビン + 連続係数列」だけを保持する。
+// 正規化（面積 = 帯域幅で割る）は旧実装と同一。
+// ============================================================
+struct SparseMelFilterbank {
+    struct Band {
+        int                first = 0;   // 最初の非ゼロビン
+        std::vector<float> weights;     // 連続する非ゼロ係数
+    };
+    std::array<Band, kMelBands> bands;
+
+    SparseMelFilterbank() {
+        auto hz_to_mel = [](float hz) {
+            return 2595.0f * std::log10(1.0f + hz / 700.0f);
+        };
+        auto mel_to_hz = [](float mel) {
+            return 700.0f * (std::pow(10.0f, mel / 2595.0f) - 1.0f);
+        };
+
+        const float mel_min = hz_to_mel(kFMin);
+        const float mel_max = hz_to_mel(kFMax);
+        std::vector<float> mel_pts(kMelBands + 2);
+        for (int m = 0; m < kMelBands + 2; ++m)
+            mel_pts[m] = mel_to_hz(
+                mel_min + (mel_max - mel_min) * m / (kMelBands + 1));
+
+        for (int m = 0; m < kMelBands; ++m) {
+            const float norm = 2.0f / (mel_pts[m+2] - mel_pts[m]); // 面積正規化
+            Band& band = bands[m];
+            band.first = -1;
+            for (int k = 0; k < kSpecBins; ++k) {
+                const float hz = k * kSR / kMelNFft;
+                float w = 0.0f;
+                if (hz >= mel_pts[m] && hz <= mel_pts[m+1])
+                    w = norm * (hz - mel_pts[m])
+                             / (mel_pts[m+1] - mel_pts[m]);
+                else if (hz > mel_pts[m+1] && hz <= mel_pts[m+2])
+                    w = norm * (mel_pts[m+2] - hz)
+                             / (mel_pts[m+2] - mel_pts[m+1]);
+                if (w > 0.0f) {
+                    if (band.first < 0) band.first = k;
+                    band.weights.push_back(w);
+                } else if (band.first >= 0) {
+                    break;   // 非ゼロ区間を抜けた（連続性が前提）
+                }
+            }
+            if (band.first < 0) band.first = 0;   // 空バンド（理論上なし）
+        }
+    }
+};
+
+const SparseMelFilterbank& mel_filterbank() {
+    static const SparseMelFilterbank fb;   // 初回使用時に1回だけ構築
+    return fb;
+}
+
+const std::array<double, kMelNFft>& hann_window() {
+    static const std::array<double, kMelNFft> win = [] {
+        std::array<double, kMelNFft> w;
+        for (int i = 0; i < kMelNFft; ++i)
+            w[i] = 0.5 * (1.0 - std::cos(2.0 * M_PI * i / kMelNFft));
+        return w;
+    }();
+    return win;
+}
+
+// ============================================================
+// スレッドごとの rdft プラン
+//
+// fft_plan は in/out ポインタを作成時に束縛するため、バッファと
+// セットで thread_local に保持して使い回す（tl_scratch と同じ方式）。
+// ワーカースレッド終了時にデストラクタでプランを破棄する。
+// ============================================================
+struct MelFFTPlan {
+    std::vector<double>      in;
+    std::vector<fft_complex> out;
+    fft_plan                 plan;
+
+    MelFFTPlan() : in(kMelNFft, 0.0), out(kSpecBins) {
+        plan = fft_plan_dft_r2c_1d(kMelNFft, in.data(), out.data(),
+                                   FFT_ESTIMATE);
+    }
+    ~MelFFTPlan() { fft_destroy_plan(plan); }
+
+    MelFFTPlan(const MelFFTPlan&)            = delete;
+    MelFFTPlan& operator=(const MelFFTPlan&) = delete;
+};
+
+thread_local MelFFTPlan tl_mel_fft;
+
+}  // namespace
+
+int compute_mel_spectrogram(const float* pcm, int n_samples,
+                            std::vector<float>& mel)
+{
+    if (!pcm || n_samples <= 0) { mel.clear(); return 0; }
+
+    const int n_frames = (n_samples + kMelHop - 1) / kMelHop;
+    mel.assign(static_cast<size_t>(n_frames) * kMelBands,
+               std::log(kLogFloor));
+
+    const SparseMelFilterbank& fb  = mel_filterbank();
+    const auto&                win = hann_window();
+
+    // フレームレンジをワーカー数で分割する。各タスクは自スレッドの
+    // rdft プランと mel の自レンジにしか触れないので同期不要
+    const int n_workers = std::max(1, vose_worker_pool().worker_count());
+    const int frames_per_task = (n_frames + n_workers - 1) / n_workers;
+
+    TaskGroup tg;
+    for (int w = 0; w < n_workers; ++w) {
+        const int t0 = w * frames_per_task;
+        const int t1 = std::min(n_frames, t0 + frames_per_task);
+        if (t0 >= t1) break;
+
+        tg.run(vose_worker_pool(), [=, &fb, &win, &mel] {
+            MelFFTPlan& fft = tl_mel_fft;
+            std::array<float, kSpecBins> power;
+
+            for (int t = t0; t < t1; ++t) {
+                const int center = t * kMelHop;
+                for (int i = 0; i < kMelNFft; ++i) {
+                    const int s = center - kMelNFft / 2 + i;
+                    fft.in[i] = (s >= 0 && s < n_samples)
+                        ? static_cast<double>(pcm[s]) * win[i]
+                        : 0.0;
+                }
+
+                fft_execute(fft.plan);
+
+                for (int k = 0; k < kSpecBins; ++k)
+                    power[k] = static_cast<float>(
+                        fft.out[k][0] * fft.out[k][0] +
+                        fft.out[k][1] * fft.out[k][1]);
+
+                float* dst = &mel[static_cast<size_t>(t) * kMelBands];
+                for (int m = 0; m < kMelBands; ++m) {
+                    const SparseMelFilterbank::Band& band = fb.bands[m];
+                    const float* pw = power.data() + band.first;
+                    float val = 0.0f;
+                    for (size_t k = 0; k < band.weights.size(); ++k)
+                        val += band.weights[k] * pw[k];
+                    dst[m] = std::log(std::max(val, kLogFloor));
+                }
+            }
+        });
+    }
+    tg.wait();
+
+    return n_frames;
+}
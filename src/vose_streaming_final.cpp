@@ -23,9 +23,11 @@
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstring>
 #include <deque>
 #include <memory>
 #include <mutex>
+#include <type_traits>
 
 // --- clamp polyfill (for C++14/macOS libc++) ---
 #ifndef HAVE_STD_CLAMP
@@ -53,6 +55,8 @@ constexpr const T& clamp(const T& v, const T& lo, const T& hi) {
 // ============================================================
 template<typename T>
 class RingBuffer {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "RingBuffer requires trivially copyable elements (memcpy)");
 public:
     explicit RingBuffer(size_t capacity)
         : mask_(next_pow2(capacity) - 1)
@@ -60,11 +64,15 @@ public:
         , head_(0), tail_(0) {}
 
     // 生産者 (合成スレッド): n 要素書き込む
+    // 折り返しを挟んで最大2回のバルク memcpy（旧実装は要素単位コピー）
     bool write(const T* src, size_t n) {
         const uint64_t h = head_.load(std::memory_order_relaxed);
         const uint64_t t = tail_.load(std::memory_order_acquire);
         if ((mask_ + 1) - static_cast<size_t>(h - t) < n) return false;
-        for (size_t i = 0; i < n; ++i) buf_[(h + i) & mask_] = src[i];
+        const size_t start = static_cast<size_t>(h) & mask_;
+        const size_t first = std::min(n, mask_ + 1 - start);
+        std::memcpy(buf_.data() + start, src, first * sizeof(T));
+        std::memcpy(buf_.data(), src + first, (n - first) * sizeof(T));
         head_.store(h + n, std::memory_order_release);
         return true;
     }
@@ -74,24 +82,57 @@ public:
         const uint64_t t      = tail_.load(std::memory_order_relaxed);
         const uint64_t h      = head_.load(std::memory_order_acquire);
         const size_t   actual = std::min(n, static_cast<size_t>(h - t));
-        for (size_t i = 0; i < actual; ++i) dst[i] = buf_[(t + i) & mask_];
+        const size_t   start  = static_cast<size_t>(t) & mask_;
+        const size_t   first  = std::min(actual, mask_ + 1 - start);
+        std::memcpy(dst, buf_.data() + start, first * sizeof(T));
+        std::memcpy(dst + first, buf_.data(), (actual - first) * sizeof(T));
         tail_.store(t + actual, std::memory_order_release);
         return actual;
     }
 
+    // 消費者 (ゼロコピー取得): 読み出し可能な連続領域を最大2つ返す。
+    // 折り返しをまたぐ場合のみ第2セグメントが非空になる。
+    // 返した領域は commit(n) するまで生産者に上書きされない。
+    size_t acquire(const T** p1, size_t* n1, const T** p2, size_t* n2) const {
+        const uint64_t t     = tail_.load(std::memory_order_relaxed);
+        const uint64_t h     = head_.load(std::memory_order_acquire);
+        const size_t   avail = static_cast<size_t>(h - t);
+        const size_t   start = static_cast<size_t>(t) & mask_;
+        const size_t   first = std::min(avail, mask_ + 1 - start);
+        *p1 = buf_.data() + start;
+        *n1 = first;
+        *p2 = buf_.data();
+        *n2 = avail - first;
+        return avail;
+    }
+
+    // 消費者: acquire で消費した分を確定して tail を進める
+    void commit(size_t n) {
+        tail_.store(tail_.load(std::memory_order_relaxed) + n,
+                    std::memory_order_release);
+    }
+
     size_t available() const {
         return static_cast<size_t>(
             head_.load(std::memory_order_acquire) -
             tail_.load(std::memory_order_relaxed));
     }
 
+    size_t capacity() const { return mask_ + 1; }
+
+    // 生産者側の空き容量の目安（write 内で再チェックされる）
+    size_t free_space() const { return capacity() - available(); }
+
 private:
     static size_t next_pow2(size_t v) {
         --v; for (size_t i=1; i<sizeof(size_t)*8; i<<=1) v|=v>>i; return ++v;
     }
     const size_t          mask_;
     std::vector<T>        buf_;
-    std::atomic<uint64_t> head_, tail_;
+    // head_ と tail_ を別キャッシュラインに置き、生産者と消費者の
+    // 更新が互いの行を無効化しない（false sharing 防止）ようにする
+    alignas(64) std::atomic<uint64_t> head_;
+    alignas(64) std::atomic<uint64_t> tail_;
 };
 
 // ============================================================
@@ -107,6 +148,11 @@ struct QueuedNote {
 class NoteQueue {
 public:
     // note_id が既存と衝突 → そこ以降を破棄して差し替え（リアルタイム編集の核心）
+    //
+    // 差し替え対象が投機合成中（in-flight）のノートだった場合は、
+    // それ以降の系列すべてが古いのでキューを空にし、世代番号を進める。
+    // synth_loop はコミット直前に世代を照合し、進んでいたら未コミットの
+    // 投機結果を破棄する。
     void push(const VoseStreamNote& n) {
         QueuedNote qn;
         qn.note_id      = n.note_id;
@@ -124,28 +170,59 @@ public:
         fill(n.breath_curve,  qn.breath_curve,  0.5);
 
         std::unique_lock<std::mutex> lk(mu_);
-        for (auto it = q_.begin(); it != q_.end(); ++it) {
-            if (it->note_id == n.note_id) { q_.erase(it, q_.end()); break; }
+        bool replaced_inflight = false;
+        for (int64_t id : inflight_) {
+            if (id == n.note_id) { replaced_inflight = true; break; }
+        }
+        if (replaced_inflight) {
+            q_.clear();
+            ++generation_;
+        } else {
+            for (auto it = q_.begin(); it != q_.end(); ++it) {
+                if (it->note_id == n.note_id) { q_.erase(it, q_.end()); break; }
+            }
         }
         q_.push_back(std::move(qn));
         cv_.notify_one();
     }
 
-    bool pop(QueuedNote& out, const std::atomic<bool>& cancelled) {
+    // 先頭ノートをブロッキングで待ち、続くノートを最大 max 個まで
+    // まとめて取り出す（先読み合成用）。取り出したノートは in-flight
+    // として記録し、取り出し時点の世代番号を *generation に返す。
+    bool pop_batch(std::vector<QueuedNote>& out, int max,
+                   const std::atomic<bool>& cancelled, uint64_t* generation) {
         std::unique_lock<std::mutex> lk(mu_);
         cv_.wait(lk, [&]{ return !q_.empty() || cancelled.load(); });
         if (cancelled.load()) return false;
-        out = std::move(q_.front());
-        q_.pop_front();
+        out.clear();
+        inflight_.clear();
+        while (!q_.empty() && static_cast<int>(out.size()) < max) {
+            inflight_.push_back(q_.front().note_id);
+            out.push_back(std::move(q_.front()));
+            q_.pop_front();
+        }
+        *generation = generation_;
         return true;
     }
 
+    uint64_t generation() {
+        std::unique_lock<std::mutex> lk(mu_);
+        return generation_;
+    }
+
+    void clear_inflight() {
+        std::unique_lock<std::mutex> lk(mu_);
+        inflight_.clear();
+    }
+
     void cancel() { std::unique_lock<std::mutex> lk(mu_); cv_.notify_all(); }
 
 private:
     std::mutex              mu_;
     std::condition_variable cv_;
     std::deque<QueuedNote>  q_;
+    std::vector<int64_t>    inflight_;   // 投機合成中の note_id（キュー順で先頭側）
+    uint64_t                generation_ = 0;
 };
 
 // ============================================================
@@ -159,6 +236,11 @@ public:
         , cancelled_(false)
         , position_ms_(0.0)
         , tempo_bpm_(cfg.initial_tempo_bpm > 0.0f ? cfg.initial_tempo_bpm : 120.0f)
+        // 低レイテンシプロファイル: buffer_ms を小さく設定したセッションは
+        // pull のたびに即時ウェイクする（新しい config フィールドを足すと
+        // ctypes 側の VoseStreamConfig と ABI がずれるため、buffer_ms から導出）
+        , low_latency_(cfg.buffer_ms <= 100)
+        , wake_threshold_ms_(static_cast<double>(cfg.buffer_ms) * 0.75)
     {
         worker_ = std::thread([this]{ synth_loop(); });
     }
@@ -166,129 +248,282 @@ public:
     ~StreamingSynthesizer() {
         cancelled_.store(true);
         note_queue_.cancel();
+        wake_cv_.notify_all();
         if (worker_.joinable()) worker_.join();
     }
 
     void   push_note(const VoseStreamNote& n)  { note_queue_.push(n); }
-    int    pull(float* out, int n)              { return static_cast<int>(ring_.read(out, n)); }
+    size_t available() const                   { return ring_.available(); }
+    int    quality_tier() const                { return quality_tier_.load(std::memory_order_relaxed); }
+
+    int pull(float* out, int n) {
+        const int got = static_cast<int>(ring_.read(out, n));
+        // 要求分を満たせなかった = 再生側が無音を埋めることになる。
+        // （ストリーム開始直後・終端でも計上されるが、定常再生中の
+        //   増加が見えれば十分なので区別しない）
+        if (got < n)
+            g_engine_stats.stream_underruns.fetch_add(
+                1, std::memory_order_relaxed);
+        if (got > 0) {
+            // 低水位を割ったら合成スレッドを起こす（イベント駆動の核心）。
+            // 低レイテンシプロファイルでは読むたびに即時ウェイク。
+            if (low_latency_ || buffered_ms() <= wake_threshold_ms_)
+                wake_cv_.notify_one();
+        }
+        return got;
+    }
+
+    // ゼロコピー読み出し: リング内部の連続領域をそのまま公開する。
+    // commit(n) を呼ぶまで tail は進まない（= n サンプル消費を確定）。
+    int acquire(const float** p1, int* n1, const float** p2, int* n2) {
+        size_t s1 = 0, s2 = 0;
+        const size_t total = ring_.acquire(p1, &s1, p2, &s2);
+        *n1 = static_cast<int>(s1);
+        *n2 = static_cast<int>(s2);
+        return static_cast<int>(total);
+    }
+
+    void commit(int n) {
+        if (n <= 0) return;
+        ring_.commit(static_cast<size_t>(n));
+        // pull() と同じウェイクアップ規約
+        if (low_latency_ || buffered_ms() <= wake_threshold_ms_)
+            wake_cv_.notify_one();
+    }
     double buffered_ms() const                 { return static_cast<double>(ring_.available()) / cfg_.sample_rate * 1000.0; }
     void   set_tempo(float bpm)                { tempo_bpm_.store(bpm); }
 
 private:
+    // 投機合成1件分の状態
+    struct SpeculativeNote {
+        std::shared_ptr<const EmbeddedVoice> ev, prev_ev;
+        const OtoEntry*     oto = nullptr;
+        int64_t             note_samples = 0;
+        bool                renderable = false;
+        std::vector<double> buf;
+    };
+
     // ============================================================
     // synth_loop — 合成スレッド本体
     //
     //   synthesize_note_impl を呼ぶことで execute_render と
     //   完全に同一の合成パイプラインを使う。音質の差ゼロ。
     //
+    //   先読み並列化:
+    //     ノート N を RingBuffer に書いている間に N+1..N+k を
+    //     ワーカープールで投機合成する（tl_scratch はワーカーごとに
+    //     独立）。コミットは必ずキュー順。NoteQueue::push の note_id
+    //     差し替えが in-flight ノートに当たった場合は世代番号が進み、
+    //     未コミットの投機結果はコミット直前の照合で破棄される
+    //     （タスク自体は中断せず、結果を捨てるだけ）。
+    //
     //   バッファ制御:
     //     buffer_ms の 75% を超えたら 10ms 待機 (CPU 節約)
-    //     buffer_ms の 75% を下回ったら即座に次ノートを合成開始
+    //     buffer_ms の 75% を下回ったら即座に次バッチを合成開始
     //     → 再生カーソルに対して常に ~N ms 先行して PCM を供給
     // ============================================================
     void synth_loop() {
-        const int fft_size  = GetFFTSizeForCheapTrick(kFs_internal, nullptr);
+        // GetFFTSizeForCheapTrick は option を無条件に参照するため、
+        // デフォルト初期化したオプション経由で取得する
+        CheapTrickOption ct_opt;
+        InitializeCheapTrickOption(kFs_internal, &ct_opt);
+        const int fft_size  = ct_opt.fft_size;
         const int spec_bins = fft_size / 2 + 1;
 
+        // 先読み本数は小さく抑える: 1〜2ノート先行すれば buffer_ms は
+        // 埋まるので、深い投機は編集時の無駄打ちを増やすだけになる
+        const int look_ahead =
+            std::max(1, std::min(4, vose_worker_pool().worker_count()));
+
         std::shared_ptr<const EmbeddedVoice> prev_ev = nullptr;
-        std::vector<double> note_buf;
-        std::vector<float>  chunk;
+        std::vector<QueuedNote> batch;
+        std::vector<float>      chunk;
+
+        // 品質ガバナー用の実時間係数 (合成時間 / 音声時間) の指数移動平均
+        double rtf_ema = -1.0;
 
         while (!cancelled_.load()) {
-            // バッファが十分埋まっていたら待機
-            while (!cancelled_.load() &&
-                   buffered_ms() > static_cast<double>(cfg_.buffer_ms) * 0.75) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            // バッファが十分埋まっていたら pull が低水位を割るまでブロック
+            // （旧実装は 10ms スリープのポーリング。定期タイマー起床が
+            //   無くなり、ストール解消も最大10ms遅れから即時ウェイクになる）
+            {
+                std::unique_lock<std::mutex> lk(wake_mu_);
+                wake_cv_.wait(lk, [&] {
+                    return cancelled_.load() ||
+                           buffered_ms() <= wake_threshold_ms_;
+                });
             }
             if (cancelled_.load()) break;
 
-            // 次ノートを取得（ブロッキング）
-            QueuedNote qn;
-            if (!note_queue_.pop(qn, cancelled_)) break;
-
-            const int pl = qn.pitch_length;
-            if (pl <= 0) { prev_ev = nullptr; continue; }
-
-            // ボイス解決
-            auto ev = find_voice_ref(qn.wav_path.c_str());
-            if (!ev) { prev_ev = nullptr; continue; }
-
-            // NoteEvent を一時構築（カーブはスタック上のベクタを直接ポイント）
-            NoteEvent tmp_n = {};
-            tmp_n.wav_path      = qn.wav_path.c_str();
-            tmp_n.pitch_length  = pl;
-            tmp_n.pitch_curve   = qn.pitch_curve.data();
-            tmp_n.gender_curve  = qn.gender_curve.data();
-            tmp_n.tension_curve = qn.tension_curve.data();
-            tmp_n.breath_curve  = qn.breath_curve.data();
-
-            // oto.ini エントリ取得（streaming でも正しくタイムマッピングする）
-            const OtoEntry* found_oto = nullptr;
-            {
-                std::unique_lock<std::mutex> lk(g_oto_db_mutex);
-                auto it = g_oto_db.find(qn.wav_path);
-                if (it != g_oto_db.end()) found_oto = &it->second;
+            // 次ノート群を取得（先頭はブロッキング、残りは先読み）
+            uint64_t gen = 0;
+            if (!note_queue_.pop_batch(batch, look_ahead, cancelled_, &gen))
+                break;
+
+            // --- 前処理: ボイス解決と prev_ev 連鎖はキュー順に直列で ---
+            // prev_ev 本体はコミット時にのみ進める（末尾差し替えで投機分が
+            // 破棄されたとき、次バッチが最後にコミットした声と正しく
+            // クロスフェードするため）。連鎖の仮計算はローカルコピーで行う。
+            std::shared_ptr<const EmbeddedVoice> chain_prev = prev_ev;
+            std::vector<SpeculativeNote> specs(batch.size());
+            // スナップショットをバッチごとに1回取得する。sp.oto は
+            // スナップショット内を指すため、バッチ処理中はこの
+            // shared_ptr を生かしておくこと（ループ末尾まで有効）
+            const auto oto_snap   = oto_snapshot();
+            const auto voice_snap = voice_snapshot();
+            for (size_t i = 0; i < batch.size(); ++i) {
+                SpeculativeNote& sp = specs[i];
+                const QueuedNote& qn = batch[i];
+                if (qn.pitch_length <= 0) { chain_prev = nullptr; continue; }
+
+                const auto* evp = voice_snap->find(qn.wav_path.c_str());
+                sp.ev = evp ? *evp : nullptr;
+                if (!sp.ev) { chain_prev = nullptr; continue; }
+
+                // oto.ini エントリ取得（streaming でも正しくタイムマッピングする）
+                sp.oto = oto_snap->find(qn.wav_path.c_str());
+
+                // note_samples (execute_render と同じ計算式)
+                sp.note_samples =
+                    (static_cast<int64_t>(qn.pitch_length) - 1) *
+                    kFramePeriod_internal / 1000.0 * kFs_internal + 1;
+                sp.prev_ev    = chain_prev;  // クロスフェード用前ノートボイス
+                sp.renderable = true;
+                chain_prev    = sp.ev;
             }
 
-            // note_samples (execute_render と同じ計算式)
-            const int64_t note_samples =
-                (static_cast<int64_t>(pl) - 1) *
-                kFramePeriod_internal / 1000.0 * kFs_internal + 1;
-
-            // NotePrepass 構築
-            // prev_ev を渡すことで blend_transition_spectra が自動的に適用される
-            NotePrepass pp(
-                NoteState::RENDERABLE,
-                note_samples,
-                ev,
-                prev_ev,    // クロスフェード用前ノートボイス
-                found_oto   // oto.ini エントリ（タイムマッピングに使用）
-            );
-
             // ===================================================
-            // 合成 — execute_render と完全同一のパイプライン
+            // 投機合成 — execute_render と完全同一のパイプライン
             //   Harvest → CheapTrick → D4C → VOSE_Synthesis
             //   gender/tension/breath/vibrato/blend も全て適用
             // ===================================================
-            SynthNoteParams params{ pp, tmp_n, fft_size, spec_bins };
-            synthesize_note_impl(params, note_buf);
-
-            // クロスフェードのフェードイン (先頭だけ前ノートとブレンド)
-            const int xfade = (prev_ev != nullptr) ? kCrossfadeSamples_internal : 0;
-            const int64_t out_len = static_cast<int64_t>(note_buf.size());
-
-            chunk.resize(out_len);
-            for (int64_t s = 0; s < out_len; ++s) {
-                double v = note_buf[s];
-                if (s < xfade) {
-                    const double fi = 0.5 * (1.0 - std::cos(M_PI * s / xfade));
-                    v *= fi;
+            const int tier = quality_tier_.load(std::memory_order_relaxed);
+            const auto synth_t0 = std::chrono::steady_clock::now();
+
+            TaskGroup tg;
+            for (size_t i = 0; i < specs.size(); ++i) {
+                if (!specs[i].renderable) continue;
+                tg.run(vose_worker_pool(),
+                       [&batch, &specs, i, fft_size, spec_bins, tier] {
+                    SpeculativeNote& sp = specs[i];
+                    const QueuedNote& qn = batch[i];
+
+                    // NoteEvent を一時構築（カーブは batch のベクタを直接ポイント）
+                    NoteEvent tmp_n = {};
+                    tmp_n.wav_path      = qn.wav_path.c_str();
+                    tmp_n.pitch_length  = qn.pitch_length;
+                    tmp_n.pitch_curve   = const_cast<double*>(qn.pitch_curve.data());
+                    tmp_n.gender_curve  = const_cast<double*>(qn.gender_curve.data());
+                    tmp_n.tension_curve = const_cast<double*>(qn.tension_curve.data());
+                    tmp_n.breath_curve  = const_cast<double*>(qn.breath_curve.data());
+
+                    // prev_ev を渡すことで blend_transition_spectra が自動適用
+                    NotePrepass pp(NoteState::RENDERABLE, sp.note_samples,
+                                   sp.ev, sp.prev_ev, sp.oto);
+                    SynthNoteParams params{ pp, tmp_n, fft_size, spec_bins };
+                    params.quality_tier = tier;
+                    synthesize_note_impl(params, sp.buf);
+                });
+            }
+            tg.wait();
+
+            // RTF (実時間係数) の更新: 合成に掛かった壁時計時間を
+            // 生成した音声時間で割る。バッチ合計で測るので並列化の
+            // 効果込みの実効値になる
+            {
+                const double synth_sec = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - synth_t0).count();
+                double audio_sec = 0.0;
+                for (const auto& sp : specs)
+                    if (sp.renderable)
+                        audio_sec += static_cast<double>(sp.note_samples)
+                                     / kFs_internal;
+                if (audio_sec > 0.0) {
+                    const double rtf = synth_sec / audio_sec;
+                    rtf_ema = (rtf_ema < 0.0)
+                        ? rtf : rtf_ema * 0.7 + rtf * 0.3;
                 }
-                chunk[s] = static_cast<float>(clamp(v, -1.0, 1.0));
             }
 
-            // RingBuffer に書き込み（満杯なら待機してリトライ）
-            size_t written = 0;
-            while (written < static_cast<size_t>(out_len) && !cancelled_.load()) {
-                const size_t remain = static_cast<size_t>(out_len) - written;
-                if (ring_.write(chunk.data() + written, remain)) {
-                    written += remain;
-                    if (cfg_.on_chunk_ready) {
-                        cfg_.on_chunk_ready(chunk.data(), static_cast<int>(out_len),
-                                            position_ms_.load(), cfg_.callback_user_data);
+            // --- キュー順にコミット。世代が進んでいたら残りは破棄 ---
+            for (size_t i = 0; i < specs.size(); ++i) {
+                if (cancelled_.load()) break;
+                if (note_queue_.generation() != gen) {
+                    // 末尾差し替え発生: i 以降の投機結果は古い系列
+                    break;
+                }
+                SpeculativeNote& sp = specs[i];
+                if (!sp.renderable) { prev_ev = nullptr; continue; }
+
+                // クロスフェードのフェードイン (先頭だけ前ノートとブレンド)
+                const int xfade =
+                    (sp.prev_ev != nullptr) ? kCrossfadeSamples_internal : 0;
+                const int64_t out_len = static_cast<int64_t>(sp.buf.size());
+
+                chunk.resize(out_len);
+                for (int64_t s = 0; s < out_len; ++s) {
+                    double v = sp.buf[s];
+                    if (s < xfade) {
+                        const double fi = 0.5 * (1.0 - std::cos(M_PI * s / xfade));
+                        v *= fi;
+                    }
+                    chunk[s] = static_cast<float>(clamp(v, -1.0, 1.0));
+                }
+
+                // RingBuffer に書き込み（満杯なら待機してリトライ）
+                size_t written = 0;
+                while (written < static_cast<size_t>(out_len) &&
+                       !cancelled_.load()) {
+                    const size_t remain = static_cast<size_t>(out_len) - written;
+                    if (ring_.write(chunk.data() + written, remain)) {
+                        written += remain;
+                        if (cfg_.on_chunk_ready) {
+                            cfg_.on_chunk_ready(chunk.data(), static_cast<int>(out_len),
+                                                position_ms_.load(), cfg_.callback_user_data);
+                        }
+                    } else {
+                        // リング満杯: pull が空きを作るのを待つ。通知は低水位
+                        // 割れ時のみ飛ぶため、満杯のまま高水位で推移する稀な
+                        // ケースに備えてタイムアウト付きで再試行する
+                        std::unique_lock<std::mutex> lk(wake_mu_);
+                        wake_cv_.wait_for(lk, std::chrono::milliseconds(100),
+                            [&] {
+                                return cancelled_.load() ||
+                                       ring_.free_space() >= remain;
+                            });
                     }
-                } else {
-                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
                 }
-            }
 
-            // タイムスタンプ更新（クロスフェード分を差し引く）
-            // std::atomic<double>はfetch_add未サポートのためload/setで加算
-            double pos = position_ms_.load();
-            pos += static_cast<double>(out_len - xfade) / kFs_internal * 1000.0;
-            position_ms_.store(pos);
+                // タイムスタンプ更新（クロスフェード分を差し引く）
+                // std::atomic<double>はfetch_add未サポートのためload/setで加算
+                double pos = position_ms_.load();
+                pos += static_cast<double>(out_len - xfade) / kFs_internal * 1000.0;
+                position_ms_.store(pos);
 
-            prev_ev = ev;  // 次ノートのクロスフェード用
+                prev_ev = sp.ev;  // 次ノートのクロスフェード用
+            }
+            note_queue_.clear_inflight();
+
+            // ============================================================
+            // 品質ガバナー — バッファ残量と RTF でティアを昇降する
+            //
+            // 昇格: 残量が危険水位 (25%) を割り、かつ合成が実時間に
+            //       追いつけていない（RTF > 0.85）とき1段ずつ。
+            // 降格: 残量が十分回復 (90%) し、かつ余裕がある
+            //       (RTF < 0.60) ときだけ1段ずつ。
+            // 閾値の非対称がヒステリシスになり、境界での振動を防ぐ。
+            // ============================================================
+            {
+                const double buf_ms = buffered_ms();
+                const double target = static_cast<double>(cfg_.buffer_ms);
+                int t = quality_tier_.load(std::memory_order_relaxed);
+                if (buf_ms < target * 0.25 && rtf_ema > 0.85)
+                    t = std::min(3, t + 1);
+                else if (buf_ms > target * 0.90 && rtf_ema >= 0.0 &&
+                         rtf_ema < 0.60)
+                    t = std::max(0, t - 1);
+                quality_tier_.store(t, std::memory_order_relaxed);
+            }
         }
     }
 
@@ -299,6 +534,122 @@ private:
     std::atomic<bool>       cancelled_;
     std::atomic<double>     position_ms_;
     std::atomic<float>      tempo_bpm_;
+
+    // イベント駆動ウェイクアップ (pull → 合成スレッド)
+    std::mutex              wake_mu_;
+    std::condition_variable wake_cv_;
+    const bool              low_latency_;
+    const double            wake_threshold_ms_;
+
+    // 品質ガバナーの現在ティア (0 = フル品質 .. 3 = Dio 解析)
+    std::atomic<int>        quality_tier_{0};
+};
+
+// ============================================================
+// StreamingMixer — マルチトラックのネイティブミックスダウン
+//
+// ハーモニースタックはこれまで StreamingSynthesizer を複数作り、
+// Python 側で pull 結果を加算していた（トラック×コールバックごとに
+// コピーと GIL 往復が発生）。ミキサーはトラックごとの NoteQueue /
+// 合成スレッドをそのまま使い、加算段だけを C++ に持つ。
+//
+// 出力はインターリーブ・ステレオ (L,R)。パンは等パワー則。
+// 各トラックの先頭 frames サンプルをゼロコピー（acquire/commit）で
+// 読みながら積和するだけなので、中間バッファも持たない。
+// frames は全トラックの残量の最小値 — トラック間のサンプル整合を
+// 保つため、1本でも合成が追いついていなければ 0 を返す。
+// ============================================================
+class StreamingMixer {
+public:
+    explicit StreamingMixer(const VoseStreamConfig& cfg) : cfg_(cfg) {}
+
+    StreamingSynthesizer* add_track() {
+        std::unique_lock<std::mutex> lk(mu_);
+        tracks_.emplace_back(new Track(cfg_));
+        return tracks_.back()->synth.get();
+    }
+
+    void set_gain(StreamingSynthesizer* t, float gain) {
+        std::unique_lock<std::mutex> lk(mu_);
+        if (Track* tr = find_track(t)) tr->gain.store(gain);
+    }
+
+    void set_pan(StreamingSynthesizer* t, float pan) {
+        std::unique_lock<std::mutex> lk(mu_);
+        if (Track* tr = find_track(t)) tr->pan.store(pan);
+    }
+
+    // ステレオ・ミックスダウン: out_lr に最大 max_frames フレーム
+    // (L,R の 2*frames float) を書き込み、フレーム数を返す
+    int pull(float* out_lr, int max_frames) {
+        std::unique_lock<std::mutex> lk(mu_);
+        if (tracks_.empty() || max_frames <= 0 || !out_lr) return 0;
+
+        size_t frames = static_cast<size_t>(max_frames);
+        for (auto& t : tracks_)
+            frames = std::min(frames, t->synth->available());
+        if (frames == 0) return 0;
+
+        std::fill_n(out_lr, frames * 2, 0.0f);
+        for (auto& t : tracks_) {
+            const float gain = t->gain.load(std::memory_order_relaxed);
+            const float pan  = clamp(
+                t->pan.load(std::memory_order_relaxed), -1.0f, 1.0f);
+            // 等パワーパン: pan=-1 で左のみ、+1 で右のみ、0 で -3dB ずつ
+            const float theta =
+                (pan + 1.0f) * 0.25f * static_cast<float>(M_PI);
+            const float gl = gain * std::cos(theta);
+            const float gr = gain * std::sin(theta);
+
+            const float* p1 = nullptr; const float* p2 = nullptr;
+            int n1 = 0, n2 = 0;
+            t->synth->acquire(&p1, &n1, &p2, &n2);
+
+            size_t done = 0;
+            auto mix_seg = [&](const float* src, size_t cnt) {
+                // 連続読みの積和のみ — -O3 -mavx2 で自動ベクトル化される
+                float* dst = out_lr + done * 2;
+                for (size_t i = 0; i < cnt; ++i) {
+                    dst[i * 2]     += src[i] * gl;
+                    dst[i * 2 + 1] += src[i] * gr;
+                }
+                done += cnt;
+            };
+            const size_t c1 = std::min(static_cast<size_t>(n1), frames);
+            mix_seg(p1, c1);
+            mix_seg(p2, std::min(static_cast<size_t>(n2), frames - c1));
+            t->synth->commit(static_cast<int>(frames));
+        }
+        return static_cast<int>(frames);
+    }
+
+    double buffered_ms() const {
+        std::unique_lock<std::mutex> lk(mu_);
+        if (tracks_.empty()) return 0.0;
+        double ms = 1e18;
+        for (auto& t : tracks_)
+            ms = std::min(ms, t->synth->buffered_ms());
+        return ms;
+    }
+
+private:
+    struct Track {
+        explicit Track(const VoseStreamConfig& cfg)
+            : synth(new StreamingSynthesizer(cfg)) {}
+        std::unique_ptr<StreamingSynthesizer> synth;
+        std::atomic<float> gain{1.0f};
+        std::atomic<float> pan{0.0f};   // -1.0 (L) .. +1.0 (R)
+    };
+
+    Track* find_track(StreamingSynthesizer* s) {
+        for (auto& t : tracks_)
+            if (t->synth.get() == s) return t.get();
+        return nullptr;
+    }
+
+    VoseStreamConfig                    cfg_;
+    mutable std::mutex                  mu_;
+    std::vector<std::unique_ptr<Track>> tracks_;
 };
 
 // ============================================================
@@ -320,10 +671,31 @@ DLLEXPORT int streaming_render_pull(VoseStreamHandle h, float* buf, int max_samp
     return static_cast<StreamingSynthesizer*>(h)->pull(buf, max_samples);
 }
 
+DLLEXPORT int streaming_render_acquire(VoseStreamHandle h,
+                                       const float** p1, int* n1,
+                                       const float** p2, int* n2) {
+    if (!h || !p1 || !n1 || !p2 || !n2) {
+        if (p1) *p1 = nullptr;
+        if (n1) *n1 = 0;
+        if (p2) *p2 = nullptr;
+        if (n2) *n2 = 0;
+        return 0;
+    }
+    return static_cast<StreamingSynthesizer*>(h)->acquire(p1, n1, p2, n2);
+}
+
+DLLEXPORT void streaming_render_commit(VoseStreamHandle h, int n) {
+    if (h) static_cast<StreamingSynthesizer*>(h)->commit(n);
+}
+
 DLLEXPORT double streaming_render_buffered_ms(VoseStreamHandle h) {
     return h ? static_cast<StreamingSynthesizer*>(h)->buffered_ms() : 0.0;
 }
 
+DLLEXPORT int streaming_render_quality_tier(VoseStreamHandle h) {
+    return h ? static_cast<StreamingSynthesizer*>(h)->quality_tier() : 0;
+}
+
 DLLEXPORT void streaming_render_set_tempo(VoseStreamHandle h, float bpm) {
     if (h && bpm > 0.0f) static_cast<StreamingSynthesizer*>(h)->set_tempo(bpm);
 }
@@ -332,4 +704,47 @@ DLLEXPORT void streaming_render_destroy(VoseStreamHandle h) {
     delete static_cast<StreamingSynthesizer*>(h);
 }
 
+// --- ミキサー ---
+
+DLLEXPORT VoseMixerHandle streaming_mixer_create(const VoseStreamConfig* cfg) {
+    if (!cfg) return nullptr;
+    return static_cast<VoseMixerHandle>(new StreamingMixer(*cfg));
+}
+
+DLLEXPORT VoseStreamHandle streaming_mixer_add_track(VoseMixerHandle m) {
+    if (!m) return nullptr;
+    return static_cast<VoseStreamHandle>(
+        static_cast<StreamingMixer*>(m)->add_track());
+}
+
+DLLEXPORT void streaming_mixer_set_track_gain(VoseMixerHandle m,
+                                              VoseStreamHandle track,
+                                              float gain) {
+    if (m && track)
+        static_cast<StreamingMixer*>(m)->set_gain(
+            static_cast<StreamingSynthesizer*>(track), gain);
+}
+
+DLLEXPORT void streaming_mixer_set_track_pan(VoseMixerHandle m,
+                                             VoseStreamHandle track,
+                                             float pan) {
+    if (m && track)
+        static_cast<StreamingMixer*>(m)->set_pan(
+            static_cast<StreamingSynthesizer*>(track), pan);
+}
+
+DLLEXPORT int streaming_mixer_pull(VoseMixerHandle m,
+                                   float* out_lr, int max_frames) {
+    if (!m) return 0;
+    return static_cast<StreamingMixer*>(m)->pull(out_lr, max_frames);
+}
+
+DLLEXPORT double streaming_mixer_buffered_ms(VoseMixerHandle m) {
+    return m ? static_cast<StreamingMixer*>(m)->buffered_ms() : 0.0;
+}
+
+DLLEXPORT void streaming_mixer_destroy(VoseMixerHandle m) {
+    delete static_cast<StreamingMixer*>(m);
+}
+
 } // extern "C"
@@ -9,6 +9,9 @@
 
 #include <math.h>
 
+#include <thread>
+#include <vector>
+
 #include "world/common.h"
 #include "world/constantnumbers.h"
 #include "world/matlabfunctions.h"
@@ -197,15 +200,20 @@ double GetF0FloorForCheapTrick(int fs, int fft_size) {
   return 3.0 * fs / (fft_size - 3.0);
 }
 
-void CheapTrick(const double *x, int x_length, int fs,
-    const double *temporal_positions, const double *f0, int f0_length,
-    const CheapTrickOption *option, double **spectrogram) {
-  int fft_size = option->fft_size;
+namespace {
 
+//-----------------------------------------------------------------------------
+// CheapTrickFrameRange() processes the frames [frame_begin, frame_end).
+// Each call owns its FFT work areas and random state, so several ranges can
+// run on different threads; spectrogram rows do not overlap between ranges.
+//-----------------------------------------------------------------------------
+static void CheapTrickFrameRange(const double *x, int x_length, int fs,
+    const double *temporal_positions, const double *f0,
+    int frame_begin, int frame_end, double f0_floor, int fft_size, double q1,
+    double **spectrogram) {
   RandnState randn_state = {};
   randn_reseed(&randn_state);
 
-  double f0_floor = GetF0FloorForCheapTrick(fs, fft_size);
   double *spectral_envelope = new double[fft_size];
 
   ForwardRealFFT forward_real_fft = {0};
@@ -214,10 +222,10 @@ void CheapTrick(const double *x, int x_length, int fs,
   InitializeInverseRealFFT(fft_size, &inverse_real_fft);
 
   double current_f0;
-  for (int i = 0; i < f0_length; ++i) {
+  for (int i = frame_begin; i < frame_end; ++i) {
     current_f0 = f0[i] <= f0_floor ? world::kDefaultF0 : f0[i];
     CheapTrickGeneralBody(x, x_length, fs, current_f0, fft_size,
-        temporal_positions[i], option->q1, &forward_real_fft,
+        temporal_positions[i], q1, &forward_real_fft,
         &inverse_real_fft, spectral_envelope, &randn_state);
     for (int j = 0; j <= fft_size / 2; ++j)
       spectrogram[i][j] = spectral_envelope[j];
@@ -228,6 +236,39 @@ void CheapTrick(const double *x, int x_length, int fs,
   delete[] spectral_envelope;
 }
 
+}  // namespace
+
+void CheapTrick(const double *x, int x_length, int fs,
+    const double *temporal_positions, const double *f0, int f0_length,
+    const CheapTrickOption *option, double **spectrogram) {
+  int fft_size = option->fft_size;
+  double f0_floor = GetF0FloorForCheapTrick(fs, fft_size);
+
+  int n_threads = option->n_threads < 1 ? 1 : option->n_threads;
+  if (n_threads > f0_length) n_threads = f0_length;
+
+  if (n_threads <= 1) {
+    CheapTrickFrameRange(x, x_length, fs, temporal_positions, f0,
+        0, f0_length, f0_floor, fft_size, option->q1, spectrogram);
+    return;
+  }
+
+  // The frame loop is embarrassingly parallel: split it into contiguous
+  // ranges, one per thread, each with its own FFT work areas.
+  std::vector<std::thread> threads;
+  threads.reserve(n_threads);
+  for (int t = 0; t < n_threads; ++t) {
+    const int frame_begin = static_cast<int>(
+        static_cast<int64_t>(f0_length) * t / n_threads);
+    const int frame_end = static_cast<int>(
+        static_cast<int64_t>(f0_length) * (t + 1) / n_threads);
+    threads.emplace_back(CheapTrickFrameRange, x, x_length, fs,
+        temporal_positions, f0, frame_begin, frame_end, f0_floor, fft_size,
+        option->q1, spectrogram);
+  }
+  for (auto &thread : threads) thread.join();
+}
+
 void InitializeCheapTrickOption(int fs, CheapTrickOption *option) {
   // q1 is the parameter used for the spectral recovery.
   // Since The parameter is optimized, you don't need to change the parameter.
@@ -237,4 +278,6 @@ void InitializeCheapTrickOption(int fs, CheapTrickOption *option) {
   // knowledge of the signal processing in CheapTrick.
   option->f0_floor = world::kFloorF0;
   option->fft_size = GetFFTSizeForCheapTrick(fs, option);
+  // Serial by default; callers opt into frame-parallel analysis.
+  option->n_threads = 1;
 }
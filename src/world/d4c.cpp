@@ -9,6 +9,8 @@
 
 #include <math.h>
 #include <algorithm>  // for std::sort()
+#include <thread>
+#include <vector>
 
 #include "world/common.h"
 #include "world/constantnumbers.h"
@@ -382,16 +384,60 @@ void D4C(const double *x, int x_length, int fs,
   for (int i = 0; i <= fft_size / 2; ++i)
     frequency_axis[i] = static_cast<double>(i) * fs / fft_size;
 
-  for (int i = 0; i < f0_length; ++i) {
-    if (f0[i] == 0 || aperiodicity0[i] <= option->threshold) continue;
-    D4CGeneralBody(x, x_length, fs, MyMaxDouble(world::kFloorF0D4C, f0[i]),
-        fft_size_d4c, temporal_positions[i], number_of_aperiodicities, window,
-        window_length, &forward_real_fft, &coarse_aperiodicity[1], &randn_state);
-
-    // Linear interpolation to convert the coarse aperiodicity into its
-    // spectral representation.
-    GetAperiodicity(coarse_frequency_axis, coarse_aperiodicity,
-        number_of_aperiodicities, frequency_axis, fft_size, aperiodicity[i]);
+  // Frame loop. Once D4C Love Train has produced aperiodicity0, the frames
+  // are fully independent; the shared inputs (window, axes, aperiodicity0)
+  // are read-only, so the loop can be split into contiguous ranges with
+  // per-thread FFT work areas and coarse aperiodicity buffers.
+  int n_threads = option->n_threads < 1 ? 1 : option->n_threads;
+  if (n_threads > f0_length) n_threads = f0_length;
+
+  auto process_frame_range = [&](int frame_begin, int frame_end,
+      const ForwardRealFFT *thread_fft, double *thread_coarse,
+      RandnState *thread_randn) {
+    for (int i = frame_begin; i < frame_end; ++i) {
+      if (f0[i] == 0 || aperiodicity0[i] <= option->threshold) continue;
+      D4CGeneralBody(x, x_length, fs, MyMaxDouble(world::kFloorF0D4C, f0[i]),
+          fft_size_d4c, temporal_positions[i], number_of_aperiodicities,
+          window, window_length, thread_fft, &thread_coarse[1], thread_randn);
+
+      // Linear interpolation to convert the coarse aperiodicity into its
+      // spectral representation.
+      GetAperiodicity(coarse_frequency_axis, thread_coarse,
+          number_of_aperiodicities, frequency_axis, fft_size, aperiodicity[i]);
+    }
+  };
+
+  if (n_threads <= 1) {
+    process_frame_range(0, f0_length, &forward_real_fft, coarse_aperiodicity,
+        &randn_state);
+  } else {
+    std::vector<std::thread> threads;
+    threads.reserve(n_threads);
+    for (int t = 0; t < n_threads; ++t) {
+      const int frame_begin = static_cast<int>(
+          static_cast<int64_t>(f0_length) * t / n_threads);
+      const int frame_end = static_cast<int>(
+          static_cast<int64_t>(f0_length) * (t + 1) / n_threads);
+      threads.emplace_back([&, frame_begin, frame_end]() {
+        RandnState thread_randn = {};
+        randn_reseed(&thread_randn);
+
+        ForwardRealFFT thread_fft = {0};
+        InitializeForwardRealFFT(fft_size_d4c, &thread_fft);
+
+        double *thread_coarse = new double[number_of_aperiodicities + 2];
+        thread_coarse[0] = -60.0;
+        thread_coarse[number_of_aperiodicities + 1] =
+          -world::kMySafeGuardMinimum;
+
+        process_frame_range(frame_begin, frame_end, &thread_fft,
+            thread_coarse, &thread_randn);
+
+        DestroyForwardRealFFT(&thread_fft);
+        delete[] thread_coarse;
+      });
+    }
+    for (auto &thread : threads) thread.join();
   }
 
   DestroyForwardRealFFT(&forward_real_fft);
@@ -404,4 +450,6 @@ void D4C(const double *x, int x_length, int fs,
 
 void InitializeD4COption(D4COption *option) {
   option->threshold = world::kThreshold;
+  // Serial by default; callers opt into frame-parallel analysis.
+  option->n_threads = 1;
 }
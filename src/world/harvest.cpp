@@ -9,6 +9,9 @@
 
 #include <math.h>
 
+#include <thread>
+#include <vector>
+
 #include "world/common.h"
 #include "world/constantnumbers.h"
 #include "world/fft.h"
@@ -331,17 +334,48 @@ static void GetF0CandidateFromRawEvent(double boundary_f0, double fs,
 //-----------------------------------------------------------------------------
 // GetRawF0Candidates() calculates f0 candidates in all channels.
 //-----------------------------------------------------------------------------
-static void GetRawF0Candidates(const double *boundary_f0_list,
-    int number_of_bands, double actual_fs, int y_length,
+static void GetRawF0CandidatesRange(const double *boundary_f0_list,
+    int band_begin, int band_end, double actual_fs, int y_length,
     const double *temporal_positions, int f0_length,
     const fft_complex *y_spectrum, int fft_size, double f0_floor,
     double f0_ceil, double **raw_f0_candidates) {
-  for (int i = 0; i < number_of_bands; ++i)
+  for (int i = band_begin; i < band_end; ++i)
     GetF0CandidateFromRawEvent(boundary_f0_list[i], actual_fs, y_spectrum,
         y_length, fft_size, f0_floor, f0_ceil, temporal_positions, f0_length,
         raw_f0_candidates[i]);
 }
 
+static void GetRawF0Candidates(const double *boundary_f0_list,
+    int number_of_bands, double actual_fs, int y_length,
+    const double *temporal_positions, int f0_length,
+    const fft_complex *y_spectrum, int fft_size, double f0_floor,
+    double f0_ceil, double **raw_f0_candidates, int n_threads) {
+  if (n_threads > number_of_bands) n_threads = number_of_bands;
+
+  if (n_threads <= 1) {
+    GetRawF0CandidatesRange(boundary_f0_list, 0, number_of_bands, actual_fs,
+        y_length, temporal_positions, f0_length, y_spectrum, fft_size,
+        f0_floor, f0_ceil, raw_f0_candidates);
+    return;
+  }
+
+  // Each channel only writes its own raw_f0_candidates row, so the
+  // channels are split into contiguous ranges, one thread per range.
+  std::vector<std::thread> threads;
+  threads.reserve(n_threads);
+  for (int t = 0; t < n_threads; ++t) {
+    const int band_begin = static_cast<int>(
+        static_cast<int64_t>(number_of_bands) * t / n_threads);
+    const int band_end = static_cast<int>(
+        static_cast<int64_t>(number_of_bands) * (t + 1) / n_threads);
+    threads.emplace_back(GetRawF0CandidatesRange, boundary_f0_list,
+        band_begin, band_end, actual_fs, y_length, temporal_positions,
+        f0_length, y_spectrum, fft_size, f0_floor, f0_ceil,
+        raw_f0_candidates);
+  }
+  for (auto &thread : threads) thread.join();
+}
+
 //-----------------------------------------------------------------------------
 // DetectF0CandidatesSub1() calculates VUV areas.
 //-----------------------------------------------------------------------------
@@ -619,17 +653,47 @@ static void GetRefinedF0(const double *x, int x_length, double fs,
 //-----------------------------------------------------------------------------
 // RefineF0() modifies the F0 by instantaneous frequency.
 //-----------------------------------------------------------------------------
-static void RefineF0Candidates(const double *x, int x_length, double fs,
-    const double *temporal_positions, int f0_length, int max_candidates,
-    double f0_floor, double f0_ceil,
+static void RefineF0CandidatesRange(const double *x, int x_length, double fs,
+    const double *temporal_positions, int frame_begin, int frame_end,
+    int max_candidates, double f0_floor, double f0_ceil,
     double **refined_f0_candidates, double **f0_scores) {
-  for (int i = 0; i < f0_length; i++)
+  for (int i = frame_begin; i < frame_end; i++)
     for (int j = 0; j < max_candidates; ++j)
       GetRefinedF0(x, x_length, fs, temporal_positions[i],
           refined_f0_candidates[i][j], f0_floor, f0_ceil,
           &refined_f0_candidates[i][j], &f0_scores[i][j]);
 }
 
+static void RefineF0Candidates(const double *x, int x_length, double fs,
+    const double *temporal_positions, int f0_length, int max_candidates,
+    double f0_floor, double f0_ceil,
+    double **refined_f0_candidates, double **f0_scores, int n_threads) {
+  if (n_threads > f0_length) n_threads = f0_length;
+
+  if (n_threads <= 1) {
+    RefineF0CandidatesRange(x, x_length, fs, temporal_positions, 0,
+        f0_length, max_candidates, f0_floor, f0_ceil, refined_f0_candidates,
+        f0_scores);
+    return;
+  }
+
+  // Frames are refined independently (each row of the candidate matrix
+  // belongs to one frame), so contiguous frame ranges are dispatched to
+  // separate threads.
+  std::vector<std::thread> threads;
+  threads.reserve(n_threads);
+  for (int t = 0; t < n_threads; ++t) {
+    const int frame_begin = static_cast<int>(
+        static_cast<int64_t>(f0_length) * t / n_threads);
+    const int frame_end = static_cast<int>(
+        static_cast<int64_t>(f0_length) * (t + 1) / n_threads);
+    threads.emplace_back(RefineF0CandidatesRange, x, x_length, fs,
+        temporal_positions, frame_begin, frame_end, max_candidates,
+        f0_floor, f0_ceil, refined_f0_candidates, f0_scores);
+  }
+  for (auto &thread : threads) thread.join();
+}
+
 //-----------------------------------------------------------------------------
 // SelectBestF0() obtains the nearlest F0 in reference_f0.
 //-----------------------------------------------------------------------------
@@ -1119,14 +1183,14 @@ static int HarvestGeneralBodySub(const double *boundary_f0_list,
     int number_of_channels, int f0_length, double actual_fs, int y_length,
     const double *temporal_positions, const fft_complex *y_spectrum,
     int fft_size, double f0_floor, double f0_ceil, int max_candidates,
-    double **f0_candidates) {
+    double **f0_candidates, int n_threads) {
   double **raw_f0_candidates = new double *[number_of_channels];
   for (int i = 0; i < number_of_channels; ++i)
     raw_f0_candidates[i] = new double[f0_length];
 
   GetRawF0Candidates(boundary_f0_list, number_of_channels,
       actual_fs, y_length, temporal_positions, f0_length, y_spectrum,
-      fft_size, f0_floor, f0_ceil, raw_f0_candidates);
+      fft_size, f0_floor, f0_ceil, raw_f0_candidates, n_threads);
 
   int number_of_candidates = DetectOfficialF0Candidates(raw_f0_candidates,
     number_of_channels, f0_length, max_candidates, f0_candidates);
@@ -1144,8 +1208,8 @@ static int HarvestGeneralBodySub(const double *boundary_f0_list,
 //-----------------------------------------------------------------------------
 static void HarvestGeneralBody(const double *x, int x_length, int fs,
     int frame_period, double f0_floor, double f0_ceil,
-    double channels_in_octave, int speed, double *temporal_positions,
-    double *f0) {
+    double channels_in_octave, int speed, int n_threads,
+    double *temporal_positions, double *f0) {
   double adjusted_f0_floor = f0_floor * 0.9;
   double adjusted_f0_ceil = f0_ceil * 1.1;
   int number_of_channels =
@@ -1188,12 +1252,12 @@ static void HarvestGeneralBody(const double *x, int x_length, int fs,
 
   int number_of_candidates = HarvestGeneralBodySub(boundary_f0_list,
     number_of_channels, f0_length, actual_fs, y_length, temporal_positions,
-    y_spectrum, fft_size, f0_floor, f0_ceil, max_candidates, f0_candidates) *
-    overlap_parameter;
+    y_spectrum, fft_size, f0_floor, f0_ceil, max_candidates, f0_candidates,
+    n_threads) * overlap_parameter;
 
   RefineF0Candidates(y, y_length, actual_fs, temporal_positions, f0_length,
       number_of_candidates, f0_floor, f0_ceil, f0_candidates,
-      f0_candidates_score);
+      f0_candidates_score, n_threads);
   RemoveUnreliableCandidates(f0_length, number_of_candidates,
       f0_candidates, f0_candidates_score);
 
@@ -1226,10 +1290,11 @@ void Harvest(const double *x, int x_length, int fs,
   double target_fs = 8000.0;
   int dimension_ratio = matlab_round(fs / target_fs);
   double channels_in_octave = 40;
+  int n_threads = option->n_threads < 1 ? 1 : option->n_threads;
 
   if (option->frame_period == 1.0) {
     HarvestGeneralBody(x, x_length, fs, 1, option->f0_floor,
-        option->f0_ceil, channels_in_octave, dimension_ratio,
+        option->f0_ceil, channels_in_octave, dimension_ratio, n_threads,
         temporal_positions, f0);
     return;
   }
@@ -1240,7 +1305,7 @@ void Harvest(const double *x, int x_length, int fs,
   double *basic_f0 = new double[basic_f0_length];
   double *basic_temporal_positions = new double[basic_f0_length];
   HarvestGeneralBody(x, x_length, fs, basic_frame_period, option->f0_floor,
-      option->f0_ceil, channels_in_octave, dimension_ratio,
+      option->f0_ceil, channels_in_octave, dimension_ratio, n_threads,
       basic_temporal_positions, basic_f0);
 
   int f0_length = GetSamplesForHarvest(fs, x_length, option->frame_period);
@@ -1259,4 +1324,6 @@ void InitializeHarvestOption(HarvestOption *option) {
   option->f0_ceil = world::kCeilF0;
   option->f0_floor = world::kFloorF0;
   option->frame_period = 5;
+  // Serial by default; callers opt into multithreaded estimation.
+  option->n_threads = 1;
 }
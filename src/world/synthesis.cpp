@@ -185,15 +185,12 @@ static void GetOneFrameSegment(double current_vuv, int noise_size,
     const double * const *spectrogram, int fft_size,
     const double * const *aperiodicity, int f0_length, double frame_period,
     double current_time, double fractional_time_shift, int fs,
-    const ForwardRealFFT *forward_real_fft,
-    const InverseRealFFT *inverse_real_fft,
-    const MinimumPhaseAnalysis *minimum_phase, const double *dc_remover,
-    double *response, RandnState* randn_state) {
-  double *aperiodic_response = new double[fft_size];
-  double *periodic_response = new double[fft_size];
+    SynthesisContext *context, double *response) {
+  double *aperiodic_response = context->aperiodic_response;
+  double *periodic_response = context->periodic_response;
 
-  double *spectral_envelope = new double[fft_size];
-  double *aperiodic_ratio = new double[fft_size];
+  double *spectral_envelope = context->spectral_envelope;
+  double *aperiodic_ratio = context->aperiodic_ratio;
   GetSpectralEnvelope(current_time, frame_period, f0_length, spectrogram,
       fft_size, spectral_envelope);
   GetAperiodicRatio(current_time, frame_period, f0_length, aperiodicity,
@@ -201,24 +198,20 @@ static void GetOneFrameSegment(double current_vuv, int noise_size,
 
   // Synthesis of the periodic response
   GetPeriodicResponse(fft_size, spectral_envelope, aperiodic_ratio,
-      current_vuv, inverse_real_fft, minimum_phase, dc_remover,
-      fractional_time_shift, fs, periodic_response);
+      current_vuv, &context->inverse_real_fft, &context->minimum_phase,
+      context->dc_remover, fractional_time_shift, fs, periodic_response);
 
   // Synthesis of the aperiodic response
   GetAperiodicResponse(noise_size, fft_size, spectral_envelope,
-      aperiodic_ratio, current_vuv, forward_real_fft,
-      inverse_real_fft, minimum_phase, aperiodic_response, randn_state);
+      aperiodic_ratio, current_vuv, &context->forward_real_fft,
+      &context->inverse_real_fft, &context->minimum_phase,
+      aperiodic_response, &context->randn_state);
 
   double sqrt_noise_size = sqrt(static_cast<double>(noise_size));
   for (int i = 0; i < fft_size; ++i)
     response[i] =
       (periodic_response[i] * sqrt_noise_size + aperiodic_response[i]) /
       fft_size;
-
-  delete[] spectral_envelope;
-  delete[] aperiodic_ratio;
-  delete[] periodic_response;
-  delete[] aperiodic_response;
 }
 
 static void GetTemporalParametersForTimeBase(const double *f0, int f0_length,
@@ -334,66 +327,122 @@ static void GetDCRemover(int fft_size, double *dc_remover) {
   }
 }
 
+//-----------------------------------------------------------------------------
+// EnsurePulseCapacity() grows the y_length-sized scratch of the context.
+// The arrays hold at most one entry per output sample.
+//-----------------------------------------------------------------------------
+static void EnsurePulseCapacity(SynthesisContext *context, int y_length) {
+  if (y_length <= context->reserved_y_length) return;
+  delete[] context->pulse_locations;
+  delete[] context->pulse_locations_index;
+  delete[] context->pulse_locations_time_shift;
+  delete[] context->interpolated_vuv;
+  context->pulse_locations = new double[y_length];
+  context->pulse_locations_index = new int[y_length];
+  context->pulse_locations_time_shift = new double[y_length];
+  context->interpolated_vuv = new double[y_length];
+  context->reserved_y_length = y_length;
+}
+
 }  // namespace
 
-void Synthesis(const double *f0, int f0_length,
-    const double * const *spectrogram, const double * const *aperiodicity,
-    int fft_size, double frame_period, int fs, int y_length, double *y) {
-  RandnState randn_state = {};
-  randn_reseed(&randn_state);
+void InitializeSynthesisContext(int fft_size, SynthesisContext *context) {
+  context->fft_size = fft_size;
+  context->randn_state = {};
+  randn_reseed(&context->randn_state);
+
+  context->minimum_phase = {0};
+  InitializeMinimumPhaseAnalysis(fft_size, &context->minimum_phase);
+  context->inverse_real_fft = {0};
+  InitializeInverseRealFFT(fft_size, &context->inverse_real_fft);
+  context->forward_real_fft = {0};
+  InitializeForwardRealFFT(fft_size, &context->forward_real_fft);
+
+  context->impulse_response = new double[fft_size];
+  context->spectral_envelope = new double[fft_size];
+  context->aperiodic_ratio = new double[fft_size];
+  context->periodic_response = new double[fft_size];
+  context->aperiodic_response = new double[fft_size];
+  context->dc_remover = new double[fft_size];
+  GetDCRemover(fft_size, context->dc_remover);
+
+  context->pulse_locations = NULL;
+  context->pulse_locations_index = NULL;
+  context->pulse_locations_time_shift = NULL;
+  context->interpolated_vuv = NULL;
+  context->reserved_y_length = 0;
+}
 
-  double *impulse_response = new double[fft_size];
+void SynthesisWithContext(SynthesisContext *context, const double *f0,
+    int f0_length, const double * const *spectrogram,
+    const double * const *aperiodicity, int fft_size, double frame_period,
+    int fs, int y_length, double *y) {
+  if (fft_size != context->fft_size) {
+    DestroySynthesisContext(context);
+    InitializeSynthesisContext(fft_size, context);
+  }
+  EnsurePulseCapacity(context, y_length);
 
   for (int i = 0; i < y_length; ++i) y[i] = 0.0;
 
-  MinimumPhaseAnalysis minimum_phase = {0};
-  InitializeMinimumPhaseAnalysis(fft_size, &minimum_phase);
-  InverseRealFFT inverse_real_fft = {0};
-  InitializeInverseRealFFT(fft_size, &inverse_real_fft);
-  ForwardRealFFT forward_real_fft = {0};
-  InitializeForwardRealFFT(fft_size, &forward_real_fft);
-
-  double *pulse_locations = new double[y_length];
-  int *pulse_locations_index = new int[y_length];
-  double *pulse_locations_time_shift = new double[y_length];
-  double *interpolated_vuv = new double[y_length];
   int number_of_pulses = GetTimeBase(f0, f0_length, fs, frame_period / 1000.0,
-      y_length, fs / fft_size + 1.0, pulse_locations, pulse_locations_index,
-      pulse_locations_time_shift, interpolated_vuv);
-
-  double *dc_remover = new double[fft_size];
-  GetDCRemover(fft_size, dc_remover);
+      y_length, fs / fft_size + 1.0, context->pulse_locations,
+      context->pulse_locations_index, context->pulse_locations_time_shift,
+      context->interpolated_vuv);
 
   frame_period /= 1000.0;
   int noise_size;
   int index, offset, lower_limit, upper_limit;
   for (int i = 0; i < number_of_pulses; ++i) {
-    noise_size = pulse_locations_index[MyMinInt(number_of_pulses - 1, i + 1)] -
-      pulse_locations_index[i];
-
-    GetOneFrameSegment(interpolated_vuv[pulse_locations_index[i]], noise_size,
-        spectrogram, fft_size, aperiodicity, f0_length, frame_period,
-        pulse_locations[i], pulse_locations_time_shift[i], fs,
-        &forward_real_fft, &inverse_real_fft, &minimum_phase, dc_remover,
-        impulse_response, &randn_state);
-    offset = pulse_locations_index[i] - fft_size / 2 + 1;
+    noise_size = context->pulse_locations_index[
+      MyMinInt(number_of_pulses - 1, i + 1)] -
+      context->pulse_locations_index[i];
+
+    GetOneFrameSegment(
+        context->interpolated_vuv[context->pulse_locations_index[i]],
+        noise_size, spectrogram, fft_size, aperiodicity, f0_length,
+        frame_period, context->pulse_locations[i],
+        context->pulse_locations_time_shift[i], fs, context,
+        context->impulse_response);
+    offset = context->pulse_locations_index[i] - fft_size / 2 + 1;
     lower_limit = MyMaxInt(0, -offset);
     upper_limit = MyMinInt(fft_size, y_length - offset);
     for (int j = lower_limit; j < upper_limit; ++j) {
       index = j + offset;
-      y[index] += impulse_response[j];
+      y[index] += context->impulse_response[j];
     }
   }
+}
 
-  delete[] dc_remover;
-  delete[] pulse_locations;
-  delete[] pulse_locations_index;
-  delete[] pulse_locations_time_shift;
-  delete[] interpolated_vuv;
-
-  DestroyMinimumPhaseAnalysis(&minimum_phase);
-  DestroyInverseRealFFT(&inverse_real_fft);
-  DestroyForwardRealFFT(&forward_real_fft);
+void DestroySynthesisContext(SynthesisContext *context) {
+  delete[] context->impulse_response;
+  delete[] context->dc_remover;
+  delete[] context->spectral_envelope;
+  delete[] context->aperiodic_ratio;
+  delete[] context->periodic_response;
+  delete[] context->aperiodic_response;
+
+  delete[] context->pulse_locations;
+  delete[] context->pulse_locations_index;
+  delete[] context->pulse_locations_time_shift;
+  delete[] context->interpolated_vuv;
+  context->pulse_locations = NULL;
+  context->pulse_locations_index = NULL;
+  context->pulse_locations_time_shift = NULL;
+  context->interpolated_vuv = NULL;
+  context->reserved_y_length = 0;
+
+  DestroyMinimumPhaseAnalysis(&context->minimum_phase);
+  DestroyInverseRealFFT(&context->inverse_real_fft);
+  DestroyForwardRealFFT(&context->forward_real_fft);
+}
 
-  delete[] impulse_response;
+void Synthesis(const double *f0, int f0_length,
+    const double * const *spectrogram, const double * const *aperiodicity,
+    int fft_size, double frame_period, int fs, int y_length, double *y) {
+  SynthesisContext context;
+  InitializeSynthesisContext(fft_size, &context);
+  SynthesisWithContext(&context, f0, f0_length, spectrogram, aperiodicity,
+      fft_size, frame_period, fs, y_length, y);
+  DestroySynthesisContext(&context);
 }